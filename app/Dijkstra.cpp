@@ -8,95 +8,277 @@
 #include "Dijkstra.hpp"
 #include "Communication.hpp"
 
+// Bit d'un point dans l'ensemble des points incohérents
+static inline uint32_t nodeBit(uint8_t node)
+{
+    return 1UL << node;
+}
+
+// Temps du virage pour passer d'une orientation à une autre. Au départ le robot tourne sur place;
+// en cours de route, il s'arrête pour un demi-tour mais prend les virages de 90 degrés en arc.
+static inline uint16_t getTurnTime(uint8_t fromHeading, uint8_t nextHeading, bool isAtStart)
+{
+    if (fromHeading == nextHeading)
+        return 0;
+    // Les orientations opposées (nord/sud, est/ouest) ont des indices dont la somme vaut 3
+    if (fromHeading + nextHeading == N_HEADINGS - 1)
+        return isAtStart ? TURN_180_TIME_MS : TURN_180_TIME_MS + NODE_CROSSING_TIME_MS;
+    return isAtStart ? TURN_90_TIME_MS : ARC_TURN_90_TIME_MS;
+}
+
+// Distance de Manhattan entre deux points: borne inférieure du coût puisque chaque segment coûte au moins 1
+static inline uint8_t getManhattanDistance(uint8_t from, uint8_t to)
+{
+    Coordinate fromPoint = toCoordinate(from);
+    Coordinate toPoint = toCoordinate(to);
+    int8_t dx = toPoint.row - fromPoint.row;
+    int8_t dy = toPoint.column - fromPoint.column;
+    return (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+}
+
 // Constructeur de la classe Dijkstra
-Dijkstra::Dijkstra()
+Dijkstra::Dijkstra(const PlannerMode &mode) : hasLearnedCosts_(false), mode_(mode)
 {
-    initMatrix(); // Initialisation de la matrice d'adjacence
+    for (uint8_t i = 0; i < N_EDGES; ++i)
+        edgeTimesMs_[i] = 0; // Aucun segment mesuré
+    resetObstacles();        // Aucun segment bloqué au départ
 }
 
-// Fonction pour initialiser la matrice d'adjacence avec des valeurs infinies
-void Dijkstra::initMatrix()
+// Débloque tous les segments: seul le masque en SRAM est remis à zéro, le graphe reste en flash
+void Dijkstra::resetObstacles()
 {
-    for (uint8_t i = 0; i < SIZE; ++i)
+    for (uint8_t i = 0; i < BLOCKED_MASK_SIZE; ++i)
+        blockedEdges_[i] = 0;
+    goal_ = NO_NODE; // L'état incrémental ne correspond plus aux coûts
+}
+
+void Dijkstra::setPlannerMode(const PlannerMode &mode)
+{
+    mode_ = mode;
+    goal_ = NO_NODE;
+}
+
+void Dijkstra::blockEdge(uint8_t edge)
+{
+    if (isEdgeBlocked(edge))
+        return;
+    blockedEdges_[edge >> 3] |= _BV(edge & 0x07);
+
+    // Seules les extrémités du segment voient leur rhs changer
+    if (goal_ != NO_NODE)
     {
-        for (uint8_t j = 0; j < SIZE; ++j)
-            matrix[i][j] = INF; // Chaque élément est initialisé à l'infini (infini n est qu'une grande valeur)
-    }
-    setCosts();
-}
-
-// Définit le coût (poids) entre deux nœuds dans la matrice d'adjacence
-void Dijkstra::setCost(uint8_t node1, uint8_t node2, const uint8_t cost)
-{
-    matrix[node1][node2] = cost; // Coût du noeud1 au noeud2
-    matrix[node2][node1] = cost; // Coût du noeud2 au noeud1 (car le graphe est non orienté)
-}
-
-void Dijkstra::setCosts()
-{
-    setCost(0, 1, 1);
-    setCost(0, 7, 1);
-    setCost(1, 2, 1);
-    setCost(2, 3, 1);
-    setCost(2, 9, 1);
-    setCost(3, 10, 1);
-    setCost(4, 5, 1);
-    setCost(5, 6, 2);
-    setCost(5, 12, 2);
-    setCost(6, 13, 1);
-    setCost(7, 8, 5);
-    setCost(8, 9, 1);
-    setCost(10, 11, 2);
-    setCost(11, 12, 1);
-    setCost(12, 13, 1);
-    setCost(8, 15, 1);
-    setCost(9, 16, 5);
-    setCost(14, 15, 2);
-    setCost(15, 16, 1);
-    setCost(16, 17, 1);
-    setCost(17, 18, 5);
-    setCost(11, 18, 5);
-    setCost(12, 19, 1);
-    setCost(13, 20, 1);
-    setCost(14, 21, 5);
-    setCost(21, 22, 1);
-    setCost(22, 23, 1);
-    setCost(16, 23, 1);
-    setCost(17, 24, 1);
-    setCost(24, 25, 2);
-    setCost(18, 25, 5);
-    setCost(25, 26, 5);
-    setCost(19, 26, 1);
-    setCost(26, 27, 1);
-    setCost(20, 27, 1);
-}
-
-// Trouve l'indice dans la matrice correspondant aux coordonnées (x, y)
-uint8_t Dijkstra::matchPoint(const Coordinate &point)
+        updateVertex(pgm_read_byte(&edgeList.edges[edge].node1));
+        updateVertex(pgm_read_byte(&edgeList.edges[edge].node2));
+    }
+}
+
+uint8_t Dijkstra::getEdgeCost(uint8_t edge) const
+{
+    if (isEdgeBlocked(edge))
+        return INF;
+    if (edgeTimesMs_[edge] == 0)
+        return pgm_read_byte(&edgeList.edges[edge].cost);
+    // Arrondi à l'unité de coût la plus proche, borné pour garder l'heuristique et les seaux valides
+    uint16_t cost = (edgeTimesMs_[edge] + EDGE_COST_UNIT_MS / 2) / EDGE_COST_UNIT_MS;
+    if (cost < 1)
+        return 1;
+    if (cost > MAX_EDGE_COST)
+        return MAX_EDGE_COST;
+    return cost;
+}
+
+uint16_t Dijkstra::getEdgeTime(uint8_t edge) const
+{
+    if (edgeTimesMs_[edge] == 0)
+        return pgm_read_byte(&edgeList.edges[edge].cost) * SEGMENT_UNIT_TIME_MS;
+    return edgeTimesMs_[edge];
+}
+
+void Dijkstra::learnSegmentTime(const Coordinate &from, const Coordinate &to, uint16_t elapsedMs)
 {
-    for (uint8_t index = 0; index < SIZE; ++index)
+    uint8_t start = matchPoint(from);
+    uint8_t end = matchPoint(to);
+    if (start == NO_NODE || end == NO_NODE || elapsedMs == 0)
+        return;
+    uint8_t edge = findEdge(start, end);
+    if (edge == NO_NODE)
+        return;
+
+    uint8_t previousCost = getEdgeCost(edge);
+    if (edgeTimesMs_[edge] == 0)
+        edgeTimesMs_[edge] = elapsedMs; // Première mesure
+    else
     {
-        if (points[index].row == point.row && points[index].column == point.column)
+        int32_t error = static_cast<int32_t>(elapsedMs) - edgeTimesMs_[edge];
+        edgeTimesMs_[edge] += error / (1 << EDGE_TIME_EMA_SHIFT);
+    }
+
+    if (getEdgeCost(edge) != previousCost)
+    {
+        hasLearnedCosts_ = true; // La table des prochains sauts ne correspond plus aux coûts
+        if (goal_ != NO_NODE)
         {
-            return index; // Retourne l'indice correspondant
+            updateVertex(start);
+            updateVertex(end);
         }
     }
-    return 100; // Retourne 100 si aucune correspondance n'est trouvée
+}
+
+uint16_t Dijkstra::getSegmentTimeout(const Coordinate &from, const Coordinate &to)
+{
+    uint8_t start = matchPoint(from);
+    uint8_t end = matchPoint(to);
+    uint8_t edge = (start == NO_NODE || end == NO_NODE) ? NO_NODE : findEdge(start, end);
+    // Segment jamais mesuré: délai d'un segment de la grille (le coût est une pénalité, pas une longueur)
+    if (edge == NO_NODE || edgeTimesMs_[edge] == 0)
+        return SEGMENT_UNIT_TIME_MS;
+    // Temps appris plus la marge
+    uint32_t timeoutMs = static_cast<uint32_t>(edgeTimesMs_[edge]) * SEGMENT_TIMEOUT_MARGIN_PERCENT / 100;
+    return (timeoutMs < MAX_SEGMENT_TIMEOUT_MS) ? timeoutMs : MAX_SEGMENT_TIMEOUT_MS;
+}
+
+bool Dijkstra::hasBlockedEdges() const
+{
+    for (uint8_t i = 0; i < BLOCKED_MASK_SIZE; ++i)
+    {
+        if (blockedEdges_[i] != 0)
+            return true;
+    }
+    return false;
+}
+
+bool Dijkstra::isEdgeBlocked(uint8_t edge) const
+{
+    return blockedEdges_[edge >> 3] & _BV(edge & 0x07);
+}
+
+// Indice du point de coordonnées (x, y), calculé directement à partir des dimensions de la grille
+uint8_t Dijkstra::matchPoint(const Coordinate &point)
+{
+    if (!isOnMap(point))
+        return NO_NODE; // Aucune correspondance
+    return toNodeIndex(point);
 }
 
 // Retourne les coordonnées du point correspondant à l'indice donné
 Coordinate Dijkstra::matchCoordinates(uint8_t position)
 {
-    return points[position]; // Retourne le point à la position donnée
+    return toCoordinate(position);
+}
+
+// Calcule le chemin le plus court entre deux points
+RoadSchema Dijkstra::generateRoad(const Coordinate &startPoint, const Coordinate &endPoint, const CardinalDirection &heading)
+{
+    // Convertit les coordonnées en indices du graphe
+    uint8_t start = matchPoint(startPoint);
+    uint8_t end = matchPoint(endPoint);
+    if (start == NO_NODE || end == NO_NODE)
+        return RoadSchema{}; // Point hors de la carte: chemin vide
+
+    uint8_t road[SIZE]; // Points du chemin, du départ à l'arrivée
+    uint8_t roadLength = findRoad(start, end, heading, road);
+    if (road[0] != start || road[roadLength - 1] != end)
+        return RoadSchema{}; // Arrivée inaccessible: chemin vide
+    return buildRoadSchema(road, roadLength);
+}
+
+// Coût total du chemin choisi par le planificateur entre deux points
+uint16_t Dijkstra::getRoadCost(const Coordinate &startPoint, const Coordinate &endPoint, CardinalDirection &heading)
+{
+    uint8_t start = matchPoint(startPoint);
+    uint8_t end = matchPoint(endPoint);
+    if (start == NO_NODE || end == NO_NODE)
+        return TIME_INF;
+    if (start == end)
+        return 0; // Aucun déplacement: l'orientation ne change pas
+
+    uint8_t road[SIZE];
+    uint8_t roadLength = findRoad(start, end, heading, road);
+    if (road[0] != start || road[roadLength - 1] != end)
+        return TIME_INF; // Arrivée inaccessible
+
+    // Même modèle de coût que la recherche: temps, virages compris, ou somme des coûts des segments
+    bool isTravelTime = (mode_ == PlannerMode::TRAVEL_TIME);
+    uint32_t cost = 0;
+    for (uint8_t i = 1; i < roadLength; ++i)
+    {
+        uint8_t edge = findEdge(road[i - 1], road[i]);
+        CardinalDirection direction = getArcDirection(road[i - 1], road[i]);
+        if (isTravelTime)
+        {
+            // Orientation inconnue au départ: le premier virage est gratuit
+            if (heading != CardinalDirection::START && heading != CardinalDirection::END)
+                cost += getTurnTime(toHeadingIndex(heading), toHeadingIndex(direction), i == 1);
+            cost += getEdgeTime(edge);
+        }
+        else
+            cost += getEdgeCost(edge);
+        heading = direction;
+    }
+
+    // Au bout d'une ligne, le robot fait demi-tour avant le trajet suivant (voir Robot::endRoadRoutine)
+    if (!hasMapRoad(endPoint, static_cast<Cardinal>(toHeadingIndex(heading))))
+    {
+        heading = toHeading(N_HEADINGS - 1 - toHeadingIndex(heading));
+        if (isTravelTime)
+            cost += TURN_180_TIME_MS;
+    }
+    return (cost < TIME_INF) ? cost : TIME_INF - 1;
+}
+
+bool Dijkstra::isReachable(const Coordinate &startPoint, const Coordinate &endPoint)
+{
+    CardinalDirection heading = CardinalDirection::START;
+    return getRoadCost(startPoint, endPoint, heading) != TIME_INF;
+}
+
+// Choisit l'algorithme selon le mode de planification et les segments bloqués
+uint8_t Dijkstra::findRoad(uint8_t start, uint8_t end, const CardinalDirection &heading, uint8_t road[])
+{
+    // La table précalculée minimise les coûts des segments sans compter les virages: le mode
+    // TRAVEL_TIME effectue donc toujours sa recherche, même sans obstacle
+    if (mode_ == PlannerMode::TRAVEL_TIME)
+        return searchFastestRoad(start, end, heading, road);
+    // Sans obstacle ni coût appris, le chemin est lu directement dans la table précalculée
+    if (!hasBlockedEdges() && !hasLearnedCosts_)
+        return walkNextHops(start, end, road);
+    if (mode_ == PlannerMode::INCREMENTAL)
+        return repairRoad(start, end, road);
+    if (mode_ == PlannerMode::BUCKET_ASTAR)
+        return searchBucketRoad(start, end, road);
+    return searchRoad(start, end, road);
 }
 
-// Calcule le chemin le plus court entre deux points en utilisant l'algorithme de Dijkstra
-RoadSchema Dijkstra::generateRoad(const Coordinate &startPoint, const Coordinate &endPoint)
+// Retrouve le segment qui relie deux points voisins
+uint8_t Dijkstra::findEdge(uint8_t from, uint8_t to)
 {
-    // Convertit les coordonnées en indices de la matrice
-    int8_t start = matchPoint(startPoint);
-    int8_t end = matchPoint(endPoint);
+    uint8_t lastArc = pgm_read_byte(&adjacency.offsets[from + 1]);
+    for (uint8_t arc = pgm_read_byte(&adjacency.offsets[from]); arc < lastArc; ++arc)
+    {
+        if (pgm_read_byte(&adjacency.arcs[arc].neighbor) == to)
+            return pgm_read_byte(&adjacency.arcs[arc].edge);
+    }
+    return NO_NODE;
+}
 
+// Parcourt la table des prochains sauts en mémoire flash du départ jusqu'à l'arrivée
+uint8_t Dijkstra::walkNextHops(uint8_t start, uint8_t end, uint8_t road[])
+{
+    uint8_t roadLength = 0;
+    road[roadLength++] = start;
+    for (uint8_t node = start; node != end && roadLength < SIZE;)
+    {
+        node = pgm_read_byte(&nextHops.next[node][end]);
+        if (node == NO_NEXT_HOP)
+            break; // Arrivée inaccessible
+        road[roadLength++] = node;
+    }
+    return roadLength;
+}
+
+// Algorithme de Dijkstra en tenant compte des segments bloqués
+uint8_t Dijkstra::searchRoad(uint8_t start, uint8_t end, uint8_t road[])
+{
     // Initialisation pour l'algorithme de Dijkstra
     bool visitedNodes[SIZE] = {false}; // Tableau des nœuds visités
     uint8_t minDistance[SIZE];         // Tableau des distances minimales
@@ -131,67 +313,336 @@ RoadSchema Dijkstra::generateRoad(const Coordinate &startPoint, const Coordinate
         visitedNodes[u] = true; // Marquer le nœud sélectionné comme visité
 
         // Mise à jour des distances et des prédécesseurs pour les voisins du nœud sélectionné
-        for (uint8_t v = 0; v < SIZE; ++v)
+        uint8_t lastArc = pgm_read_byte(&adjacency.offsets[u + 1]);
+        for (uint8_t arc = pgm_read_byte(&adjacency.offsets[u]); arc < lastArc; ++arc)
         {
-            if (!visitedNodes[v] && (matrix[u][v] != INF) && ((minDistance[u] + matrix[u][v]) < minDistance[v]))
+            uint8_t v = pgm_read_byte(&adjacency.arcs[arc].neighbor);
+            uint8_t edge = pgm_read_byte(&adjacency.arcs[arc].edge);
+            if (visitedNodes[v] || isEdgeBlocked(edge))
+                continue;
+            uint8_t cost = getEdgeCost(edge);
+            if ((minDistance[u] + cost) < minDistance[v])
             {
                 predecessors[v] = u;
-                minDistance[v] = minDistance[u] + matrix[u][v];
+                minDistance[v] = minDistance[u] + cost;
             }
         }
     }
 
-    int8_t road[SIZE]; // Utilisation d'un tableau statique pour stocker le chemin
-    int8_t roadIndex = 0;
-
     // Construction du chemin en remontant à partir du point d'arrivée
+    uint8_t roadLength = 0;
+    for (int8_t v = end; v != -1; v = predecessors[v])
+        roadLength++;
+    uint8_t index = roadLength;
     for (int8_t v = end; v != -1; v = predecessors[v])
+        road[--index] = v;
+    return roadLength;
+}
+
+// A* avec une file à seaux de Dial: f = distance + heuristique de Manhattan
+uint8_t Dijkstra::searchBucketRoad(uint8_t start, uint8_t end, uint8_t road[])
+{
+    uint8_t distance[SIZE];               // Distance minimale connue depuis le départ
+    uint8_t predecessors[SIZE];           // Point précédent sur le chemin le plus court
+    uint32_t buckets[N_BUCKETS] = {0};    // Seaux circulaires indexés par f: un bit par point ouvert
+
+    for (uint8_t i = 0; i < SIZE; ++i)
     {
-        road[roadIndex++] = v;
+        distance[i] = INF;
+        predecessors[i] = NO_NODE;
     }
-    // Parcours du chemin pour calculer la direction entre chaque point consécutif
-    // generer le roadSchema
-    RoadSchema roadSchema;
-    roadSchema.size = 0;
-    for (int8_t i = (roadIndex - 1); i > 0; --i)
+    distance[start] = 0;
+    uint8_t f = getManhattanDistance(start, end);
+    buckets[f & (N_BUCKETS - 1)] = nodeBit(start);
+    uint8_t openCount = 1;
+
+    while (openCount != 0)
     {
-        Coordinate startPt = matchCoordinates(road[i]);
-        Coordinate endPt = matchCoordinates(road[i - 1]);
+        // L'heuristique est cohérente: f ne diminue jamais, on avance jusqu'au prochain seau non vide
+        while (buckets[f & (N_BUCKETS - 1)] == 0)
+            ++f;
+        uint32_t bucket = buckets[f & (N_BUCKETS - 1)];
+        uint8_t u = 0;
+        for (; !(bucket & 1); bucket >>= 1)
+            ++u;
+        buckets[f & (N_BUCKETS - 1)] &= ~nodeBit(u);
+        --openCount;
 
-        int8_t dx = endPt.row - startPt.row;
-        int8_t dy = endPt.column - startPt.column;
+        if (u == end)
+            break; // Arrivée fixée: inutile d'explorer le reste de la carte
 
-        for (uint8_t i = 0; i < 4; i++)
+        uint8_t lastArc = pgm_read_byte(&adjacency.offsets[u + 1]);
+        for (uint8_t arc = pgm_read_byte(&adjacency.offsets[u]); arc < lastArc; ++arc)
         {
-            if (listCornersNav[i].coordinate.row == dx && listCornersNav[i].coordinate.column == dy)
+            uint8_t cost = getEdgeCost(pgm_read_byte(&adjacency.arcs[arc].edge));
+            if (cost == INF)
+                continue;
+            uint8_t v = pgm_read_byte(&adjacency.arcs[arc].neighbor);
+            uint8_t candidate = distance[u] + cost;
+            if (candidate >= distance[v])
+                continue;
+            uint8_t heuristic = getManhattanDistance(v, end);
+            if (distance[v] == INF)
+                ++openCount;
+            else
+                buckets[(distance[v] + heuristic) & (N_BUCKETS - 1)] &= ~nodeBit(v); // Retire v de son ancien seau
+            distance[v] = candidate;
+            predecessors[v] = u;
+            buckets[(candidate + heuristic) & (N_BUCKETS - 1)] |= nodeBit(v);
+        }
+    }
+
+    // Construction du chemin en remontant à partir du point d'arrivée
+    if (distance[end] == INF)
+    {
+        road[0] = start; // Arrivée inaccessible
+        return 1;
+    }
+    uint8_t roadLength = 0;
+    for (uint8_t v = end; v != NO_NODE; v = predecessors[v])
+        roadLength++;
+    uint8_t index = roadLength;
+    for (uint8_t v = end; v != NO_NODE; v = predecessors[v])
+        road[--index] = v;
+    return roadLength;
+}
+
+// Dijkstra sur les états (point, orientation) avec des coûts en millisecondes
+uint8_t Dijkstra::searchFastestRoad(uint8_t start, uint8_t end, const CardinalDirection &heading, uint8_t road[])
+{
+    uint16_t time[N_STATES];                     // Temps minimal pour atteindre chaque état
+    uint8_t predecessors[N_STATES];              // État précédent sur le chemin le plus rapide
+    uint8_t settled[(N_STATES + 7) / 8] = {0};   // États dont le temps est définitif
+
+    for (uint8_t i = 0; i < N_STATES; ++i)
+    {
+        time[i] = TIME_INF;
+        predecessors[i] = NO_NODE;
+    }
+    // Orientation inconnue: le premier virage est gratuit
+    if (heading == CardinalDirection::START || heading == CardinalDirection::END)
+    {
+        for (uint8_t h = 0; h < N_HEADINGS; ++h)
+            time[start * N_HEADINGS + h] = 0;
+    }
+    else
+        time[start * N_HEADINGS + toHeadingIndex(heading)] = 0;
+
+    uint8_t goalState = NO_NODE;
+    for (uint8_t count = 0; count < N_STATES; ++count)
+    {
+        uint8_t u = NO_NODE;
+        uint16_t minTime = TIME_INF;
+        for (uint8_t v = 0; v < N_STATES; ++v)
+        {
+            if (!(settled[v >> 3] & _BV(v & 0x07)) && time[v] < minTime)
+            {
+                u = v;
+                minTime = time[v];
+            }
+        }
+        if (u == NO_NODE)
+            break; // Plus aucun état accessible
+        settled[u >> 3] |= _BV(u & 0x07);
+
+        uint8_t node = u / N_HEADINGS;
+        if (node == end)
+        {
+            goalState = u; // Premier état de l'arrivée fixé: c'est le plus rapide
+            break;
+        }
+
+        uint8_t lastArc = pgm_read_byte(&adjacency.offsets[node + 1]);
+        for (uint8_t arc = pgm_read_byte(&adjacency.offsets[node]); arc < lastArc; ++arc)
+        {
+            uint8_t edge = pgm_read_byte(&adjacency.arcs[arc].edge);
+            if (isEdgeBlocked(edge))
+                continue;
+            uint8_t neighbor = pgm_read_byte(&adjacency.arcs[arc].neighbor);
+            uint8_t direction = toHeadingIndex(getArcDirection(node, neighbor));
+            uint8_t v = neighbor * N_HEADINGS + direction;
+            uint32_t candidate = static_cast<uint32_t>(minTime) + getEdgeTime(edge);
+            // Une intersection ne coûte du temps que pour changer de direction
+            candidate += getTurnTime(u % N_HEADINGS, direction, node == start);
+            if (candidate < time[v])
+            {
+                time[v] = static_cast<uint16_t>(candidate);
+                predecessors[v] = u;
+            }
+        }
+    }
+
+    // Construction du chemin en remontant à partir de l'état d'arrivée
+    if (goalState == NO_NODE)
+    {
+        road[0] = start; // Arrivée inaccessible
+        return 1;
+    }
+    uint8_t roadLength = 0;
+    for (uint8_t state = goalState; state != NO_NODE; state = predecessors[state])
+        roadLength++;
+    uint8_t index = roadLength;
+    for (uint8_t state = goalState; state != NO_NODE; state = predecessors[state])
+        road[--index] = state / N_HEADINGS;
+    return roadLength;
+}
+
+// Retrouve la direction cardinale correspondant au déplacement entre deux points voisins
+CardinalDirection Dijkstra::getArcDirection(uint8_t from, uint8_t to)
+{
+    Coordinate startPt = matchCoordinates(from);
+    Coordinate endPt = matchCoordinates(to);
+
+    int8_t dx = endPt.row - startPt.row;
+    int8_t dy = endPt.column - startPt.column;
+
+    for (uint8_t j = 0; j < CORNER_SIZE; j++)
+    {
+        if (listCornersNav[j].coordinate.row == dx && listCornersNav[j].coordinate.column == dy)
+        {
+            switch (listCornersNav[j].orientation)
             {
-                switch (listCornersNav[i].orientation)
-                {
-                case Cardinal::EAST:
-                    roadSchema.road[roadSchema.size++] = CardinalDirection::EAST;
-                    break;
-                case Cardinal::SOUTH:
-                    roadSchema.road[roadSchema.size++] = CardinalDirection::SOUTH;
-                    break;
-                case Cardinal::WEST:
-                    roadSchema.road[roadSchema.size++] = CardinalDirection::WEST;
-                    break;
-                case Cardinal::NORTH:
-                    roadSchema.road[roadSchema.size++] = CardinalDirection::NORTH;
-                    break;
-                default:
-                    break;
-                }
+            case Cardinal::EAST:
+                return CardinalDirection::EAST;
+            case Cardinal::SOUTH:
+                return CardinalDirection::SOUTH;
+            case Cardinal::WEST:
+                return CardinalDirection::WEST;
+            case Cardinal::NORTH:
+                return CardinalDirection::NORTH;
+            default:
                 break;
             }
         }
     }
+    return CardinalDirection::START;
+}
+
+// Initialise l'état incrémental: seule l'arrivée est cohérente au départ
+void Dijkstra::initIncremental(uint8_t goal)
+{
+    goal_ = goal;
+    for (uint8_t i = 0; i < SIZE; ++i)
+    {
+        g_[i] = INF;
+        rhs_[i] = INF;
+    }
+    rhs_[goal] = 0;
+    openNodes_ = nodeBit(goal);
+}
+
+void Dijkstra::updateVertex(uint8_t node)
+{
+    if (node != goal_)
+    {
+        uint8_t bestRhs = INF;
+        uint8_t lastArc = pgm_read_byte(&adjacency.offsets[node + 1]);
+        for (uint8_t arc = pgm_read_byte(&adjacency.offsets[node]); arc < lastArc; ++arc)
+        {
+            uint8_t v = pgm_read_byte(&adjacency.arcs[arc].neighbor);
+            uint16_t cost = getEdgeCost(pgm_read_byte(&adjacency.arcs[arc].edge)) + g_[v];
+            if (cost < bestRhs)
+                bestRhs = cost;
+        }
+        rhs_[node] = bestRhs;
+    }
+
+    if (g_[node] != rhs_[node])
+        openNodes_ |= nodeBit(node);
+    else
+        openNodes_ &= ~nodeBit(node);
+}
+
+void Dijkstra::computeShortestPath(uint8_t start)
+{
+    while (openNodes_ != 0)
+    {
+        // Point incohérent de plus petite clé min(g, rhs)
+        uint8_t u = NO_NODE;
+        uint8_t minKey = INF + 1;
+        for (uint8_t v = 0; v < SIZE; ++v)
+        {
+            uint8_t key = (g_[v] < rhs_[v]) ? g_[v] : rhs_[v];
+            if ((openNodes_ & nodeBit(v)) && key < minKey)
+            {
+                u = v;
+                minKey = key;
+            }
+        }
+
+        // Arrêt dès que le départ est cohérent et qu'aucun point plus proche ne reste à traiter
+        uint8_t startKey = (g_[start] < rhs_[start]) ? g_[start] : rhs_[start];
+        if (minKey >= startKey && g_[start] == rhs_[start])
+            break;
+
+        openNodes_ &= ~nodeBit(u);
+        if (g_[u] > rhs_[u])
+            g_[u] = rhs_[u]; // Point sur-cohérent: sa distance diminue
+        else
+        {
+            g_[u] = INF; // Point sous-cohérent: sa distance doit être recalculée
+            updateVertex(u);
+        }
+
+        uint8_t lastArc = pgm_read_byte(&adjacency.offsets[u + 1]);
+        for (uint8_t arc = pgm_read_byte(&adjacency.offsets[u]); arc < lastArc; ++arc)
+            updateVertex(pgm_read_byte(&adjacency.arcs[arc].neighbor));
+    }
+}
+
+uint8_t Dijkstra::repairRoad(uint8_t start, uint8_t end, uint8_t road[])
+{
+    if (end != goal_)
+        initIncremental(end);
+    computeShortestPath(start);
+
+    // Descente du gradient des coûts vers l'arrivée
+    uint8_t roadLength = 0;
+    road[roadLength++] = start;
+    for (uint8_t node = start; node != end && roadLength < SIZE;)
+    {
+        uint8_t next = NO_NODE;
+        uint8_t bestCost = INF;
+        uint8_t lastArc = pgm_read_byte(&adjacency.offsets[node + 1]);
+        for (uint8_t arc = pgm_read_byte(&adjacency.offsets[node]); arc < lastArc; ++arc)
+        {
+            uint8_t v = pgm_read_byte(&adjacency.arcs[arc].neighbor);
+            uint16_t cost = getEdgeCost(pgm_read_byte(&adjacency.arcs[arc].edge)) + g_[v];
+            if (cost < bestCost)
+            {
+                next = v;
+                bestCost = cost;
+            }
+        }
+        if (next == NO_NODE)
+            break; // Arrivée inaccessible
+        road[roadLength++] = next;
+        node = next;
+    }
+    return roadLength;
+}
+
+// Calcule la direction entre chaque point consécutif du chemin
+RoadSchema Dijkstra::buildRoadSchema(const uint8_t road[], uint8_t roadLength)
+{
+    RoadSchema roadSchema;
+    roadSchema.size = 0;
+    for (uint8_t i = 1; i < roadLength; ++i)
+    {
+        CardinalDirection direction = getArcDirection(road[i - 1], road[i]);
+        if (direction != CardinalDirection::START)
+            roadSchema.road[roadSchema.size++] = direction;
+    }
     return roadSchema;
 }
 
 void Dijkstra::destroyPath(const Coordinate &coordinate)
 {
     uint8_t point = matchPoint(coordinate);
-    for (uint8_t j = 0; j < SIZE; ++j)
-        matrix[point][j] = INF; // Chaque élément est initialisé à l'infini
+    if (point >= SIZE)
+        return;
+    // Bloque chaque segment qui touche le point de l'obstacle
+    uint8_t lastArc = pgm_read_byte(&adjacency.offsets[point + 1]);
+    for (uint8_t arc = pgm_read_byte(&adjacency.offsets[point]); arc < lastArc; ++arc)
+        blockEdge(pgm_read_byte(&adjacency.arcs[arc].edge));
 }
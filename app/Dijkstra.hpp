@@ -14,13 +14,15 @@
 #include "res/config.hpp"
 #include "res/struct/RoadSchema.hpp"
 #include "res/consts.hpp"
+#include "res/graph.hpp"
 
 /**
  * @class Dijkstra
  * @brief Classe implémentant l'algorithme de Dijkstra pour le calcul de chemins.
  *
  * Dijkstra fournit des méthodes pour générer des chemins optimaux entre deux points, détruire des chemins
- * en cas d'obstacles détectés, et initialiser la matrice d'adjacence utilisée pour le calcul des chemins.
+ * en cas d'obstacles détectés, et réinitialiser les obstacles connus. Le graphe est une liste d'adjacence
+ * en mémoire flash (voir res/graph.hpp); seul le masque des segments bloqués réside en SRAM.
  */
 class Dijkstra
 {
@@ -28,9 +30,11 @@ public:
     /**
      * @brief Constructeur de Dijkstra.
      *
-     * Initialise l'algorithme de Dijkstra et prépare la matrice d'adjacence.
+     * Initialise l'algorithme de Dijkstra sans aucun segment bloqué.
+     *
+     * @param mode L'algorithme utilisé pour replanifier lorsque des segments sont bloqués.
      */
-    Dijkstra();
+    Dijkstra(const PlannerMode &mode = PlannerMode::LINEAR_SCAN);
 
     /**
      * @brief Destructeur par défaut de Dijkstra.
@@ -39,52 +43,256 @@ public:
 
     /**
      * @brief Génère le chemin le plus court entre deux points.
+     *
+     * Lorsque aucun segment n'est bloqué et que les coûts appris sont égaux aux coûts fixes, le
+     * chemin est lu dans la table des prochains sauts précalculée en mémoire flash. Sinon, l'algorithme choisi par le mode de planification est
+     * exécuté: Dijkstra complet, réparation incrémentale de la recherche précédente ou A* avec
+     * file à seaux. Le mode TRAVEL_TIME ne lit jamais la table, qui ne compte pas les virages.
+     *
      * @param startPoint Le point de départ.
      * @param endPoint Le point d'arrivée.
-     * @return RoadSchema Le schéma du chemin le plus court calculé.
+     * @param heading L'orientation du robot au point de départ (START si inconnue), utilisée par le
+     *        mode TRAVEL_TIME pour compter le premier virage.
+     * @return RoadSchema Le schéma du chemin le plus court calculé (vide si l'arrivée est inaccessible).
      */
-    RoadSchema generateRoad(const Coordinate &startPoint, const Coordinate &endPoint); // Calcule et affiche le chemin le plus court
+    RoadSchema generateRoad(const Coordinate &startPoint, const Coordinate &endPoint,
+                            const CardinalDirection &heading = CardinalDirection::START); // Calcule et affiche le chemin le plus court
+
+    /**
+     * @brief Calcule le coût du chemin que le planificateur choisirait entre deux points.
+     *
+     * Le coût est exprimé dans les unités du mode de planification: temps de parcours en
+     * millisecondes, virages compris, pour TRAVEL_TIME; somme des coûts des segments sinon. Le
+     * demi-tour fait au bout d'une ligne à l'arrivée est compté, et l'orientation d'arrivée est
+     * retournée pour enchaîner les trajets d'une tournée.
+     *
+     * @param startPoint Le point de départ.
+     * @param endPoint Le point d'arrivée.
+     * @param heading L'orientation du robot au départ (START si inconnue); reçoit son orientation à l'arrivée.
+     * @return uint16_t Le coût du chemin, ou TIME_INF si l'arrivée est inaccessible.
+     */
+    uint16_t getRoadCost(const Coordinate &startPoint, const Coordinate &endPoint, CardinalDirection &heading);
+
+    /**
+     * @brief Indique si un point peut être atteint en évitant les segments bloqués.
+     * @param startPoint Le point de départ.
+     * @param endPoint Le point d'arrivée.
+     * @return true si un chemin existe, false sinon.
+     */
+    bool isReachable(const Coordinate &startPoint, const Coordinate &endPoint);
 
     /**
      * @brief Détruit un chemin en cas de détection d'obstacle.
+     *
+     * Bloque tous les segments qui touchent le point où l'obstacle a été détecté.
+     *
      * @param destroyPoint Le point où un obstacle a été détecté.
      */
     void destroyPath(const Coordinate &destroyPoint);
 
     /**
-     * @brief Initialise la matrice d'adjacence avec des valeurs infinies.
+     * @brief Intègre le temps mesuré pour parcourir un segment.
+     *
+     * Le temps appris est une moyenne mobile exponentielle des mesures. Il remplace le coût fixe du
+     * segment dans la planification et sert à calculer le délai accordé pour le parcourir.
+     *
+     * @param from Le point de départ du segment.
+     * @param to Le point d'arrivée du segment.
+     * @param elapsedMs Le temps mesuré en millisecondes.
      */
-    void initMatrix();
+    void learnSegmentTime(const Coordinate &from, const Coordinate &to, uint16_t elapsedMs);
+
+    /**
+     * @brief Retourne le délai accordé pour parcourir un segment.
+     * @param from Le point de départ du segment.
+     * @param to Le point d'arrivée du segment.
+     * @return uint16_t Le délai en millisecondes, borné à MAX_SEGMENT_TIMEOUT_MS: SEGMENT_UNIT_TIME_MS
+     *         tant que le segment n'a pas été mesuré, puis son temps appris plus la marge.
+     */
+    uint16_t getSegmentTimeout(const Coordinate &from, const Coordinate &to);
+
+    /**
+     * @brief Bloque un segment dans le masque des segments bloqués.
+     * @param edge Identifiant du segment à bloquer.
+     */
+    void blockEdge(uint8_t edge);
+
+    /**
+     * @brief Débloque tous les segments (oublie les obstacles détectés).
+     */
+    void resetObstacles();
+
+    /**
+     * @brief Change l'algorithme utilisé pour replanifier lorsque des segments sont bloqués.
+     * @param mode Le nouveau mode de planification.
+     */
+    void setPlannerMode(const PlannerMode &mode);
 
 private:
     /**
-     * @brief Définit les coûts des chemins dans la matrice d'adjacence.
+     * @brief Indique si un segment est bloqué.
+     * @param edge Identifiant du segment.
+     * @return true si le segment est bloqué, false sinon.
+     */
+    bool isEdgeBlocked(uint8_t edge) const;
+
+    /**
+     * @brief Indique si au moins un segment est bloqué.
+     * @return true si le masque des segments bloqués n'est pas vide, false sinon.
+     */
+    bool hasBlockedEdges() const;
+
+    /**
+     * @brief Calcule le chemin avec l'algorithme choisi par le mode de planification.
+     * @param start Indice du point de départ.
+     * @param end Indice du point d'arrivée.
+     * @param heading L'orientation du robot au point de départ (START si inconnue).
+     * @param road Tableau recevant les indices des points du chemin, du départ à l'arrivée.
+     * @return uint8_t Le nombre de points du chemin.
+     */
+    uint8_t findRoad(uint8_t start, uint8_t end, const CardinalDirection &heading, uint8_t road[]);
+
+    /**
+     * @brief Retrouve le segment qui relie deux points voisins.
+     * @param from Indice du premier point.
+     * @param to Indice du point voisin.
+     * @return uint8_t Identifiant du segment, ou NO_NODE si les points ne sont pas reliés.
+     */
+    uint8_t findEdge(uint8_t from, uint8_t to);
+
+    /**
+     * @brief Construit le chemin en suivant la table des prochains sauts (graphe sans obstacle).
+     * @param start Indice du point de départ.
+     * @param end Indice du point d'arrivée.
+     * @param road Tableau recevant les indices des points du chemin, du départ à l'arrivée.
+     * @return uint8_t Le nombre de points du chemin.
+     */
+    uint8_t walkNextHops(uint8_t start, uint8_t end, uint8_t road[]);
+
+    /**
+     * @brief Exécute l'algorithme de Dijkstra en évitant les segments bloqués.
+     * @param start Indice du point de départ.
+     * @param end Indice du point d'arrivée.
+     * @param road Tableau recevant les indices des points du chemin, du départ à l'arrivée.
+     * @return uint8_t Le nombre de points du chemin.
+     */
+    uint8_t searchRoad(uint8_t start, uint8_t end, uint8_t road[]);
+
+    /**
+     * @brief Exécute A* avec une file à seaux (Dial) en évitant les segments bloqués.
+     *
+     * Les coûts des segments étant de petits entiers, chaque point ouvert est rangé dans le seau
+     * de sa valeur f = distance + distance de Manhattan à l'arrivée. L'extraction du minimum ne
+     * parcourt que les seaux, et la recherche s'arrête dès que l'arrivée est atteinte.
+     *
+     * @param start Indice du point de départ.
+     * @param end Indice du point d'arrivée.
+     * @param road Tableau recevant les indices des points du chemin, du départ à l'arrivée.
+     * @return uint8_t Le nombre de points du chemin.
+     */
+    uint8_t searchBucketRoad(uint8_t start, uint8_t end, uint8_t road[]);
+
+    /**
+     * @brief Retourne le coût d'un segment, ou INF s'il est bloqué.
+     *
+     * Un segment déjà mesuré a un coût tiré de son temps appris, borné entre 1 et MAX_EDGE_COST.
+     *
+     * @param edge Identifiant du segment.
+     * @return uint8_t Le coût du segment.
+     */
+    uint8_t getEdgeCost(uint8_t edge) const;
+
+    /**
+     * @brief Retourne le temps de parcours estimé d'un segment (sans tenir compte du blocage).
+     * @param edge Identifiant du segment.
+     * @return uint16_t Le temps appris, ou le coût fixe multiplié par SEGMENT_UNIT_TIME_MS.
+     */
+    uint16_t getEdgeTime(uint8_t edge) const;
+
+    /**
+     * @brief Recherche le chemin le plus rapide sur les états (point, orientation).
+     *
+     * Le coût d'une transition est le temps en millisecondes du parcours du segment, plus l'arrêt et
+     * le virage lorsque la direction change (les lignes droites traversent les intersections sans
+     * s'arrêter). Les chemins avec moins de virages sont ainsi favorisés même s'ils sont plus longs.
+     *
+     * @param start Indice du point de départ.
+     * @param end Indice du point d'arrivée.
+     * @param heading L'orientation initiale du robot (START si inconnue).
+     * @param road Tableau recevant les indices des points du chemin, du départ à l'arrivée.
+     * @return uint8_t Le nombre de points du chemin.
+     */
+    uint8_t searchFastestRoad(uint8_t start, uint8_t end, const CardinalDirection &heading, uint8_t road[]);
+
+    /**
+     * @brief Retourne la direction cardinale pour aller d'un point à un point voisin.
+     * @param from Indice du point de départ.
+     * @param to Indice du point voisin.
+     * @return CardinalDirection La direction du déplacement (START si les points ne sont pas voisins).
+     */
+    CardinalDirection getArcDirection(uint8_t from, uint8_t to);
+
+    /**
+     * @brief Replanifie de façon incrémentale (LPA* inversé, enraciné à l'arrivée).
+     *
+     * Les valeurs g et rhs sont conservées entre les appels tant que l'arrivée ne change pas :
+     * seuls les points touchés par les segments bloqués depuis le dernier appel sont réparés.
+     *
+     * @param start Indice du point de départ (position actuelle du robot).
+     * @param end Indice du point d'arrivée.
+     * @param road Tableau recevant les indices des points du chemin, du départ à l'arrivée.
+     * @return uint8_t Le nombre de points du chemin.
+     */
+    uint8_t repairRoad(uint8_t start, uint8_t end, uint8_t road[]);
+
+    /**
+     * @brief Réinitialise l'état incrémental pour une nouvelle arrivée.
+     * @param goal Indice du point d'arrivée.
+     */
+    void initIncremental(uint8_t goal);
+
+    /**
+     * @brief Recalcule rhs d'un point et met à jour son appartenance à la file de priorité.
+     * @param node Indice du point à mettre à jour.
+     */
+    void updateVertex(uint8_t node);
+
+    /**
+     * @brief Traite la file de priorité jusqu'à ce que le point de départ soit cohérent.
+     * @param start Indice du point de départ.
      */
-    void setCosts();
+    void computeShortestPath(uint8_t start);
 
     /**
-     * @brief Définit le coût d'un chemin entre deux nœuds.
-     * @param node1 Le premier nœud.
-     * @param node2 Le second nœud.
-     * @param cost Le coût du chemin entre les deux nœuds.
+     * @brief Convertit une suite de points en schéma de directions cardinales.
+     * @param road Les indices des points du chemin, du départ à l'arrivée.
+     * @param roadLength Le nombre de points du chemin.
+     * @return RoadSchema Le schéma du chemin.
      */
-    void setCost(uint8_t node1, uint8_t node2, const uint8_t cost);
+    RoadSchema buildRoadSchema(const uint8_t road[], uint8_t roadLength);
 
     /**
-     * @brief Associe des coordonnées à une position dans la matrice.
+     * @brief Associe des coordonnées à un indice de point du graphe.
      * @param point Les coordonnées à associer.
-     * @return uint8_t La position dans la matrice correspondant aux coordonnées.
+     * @return uint8_t L'indice du point, ou NO_NODE si les coordonnées sont hors de la carte.
      */
     uint8_t matchPoint(const Coordinate &point);
 
     /**
-     * @brief Associe une position dans la matrice à des coordonnées.
-     * @param position La position dans la matrice.
-     * @return Coordinate Les coordonnées correspondant à la position dans la matrice.
+     * @brief Associe un indice de point du graphe à des coordonnées.
+     * @param position L'indice du point.
+     * @return Coordinate Les coordonnées du point.
      */
     Coordinate matchCoordinates(uint8_t position);
 
-    uint8_t matrix[SIZE][SIZE]; // Matrice d'adjacence pour les coûts des chemins.
+    uint8_t blockedEdges_[BLOCKED_MASK_SIZE]; // Masque des segments bloqués (un bit par segment).
+    uint16_t edgeTimesMs_[N_EDGES];           // Temps appris de chaque segment (0 si jamais mesuré).
+    bool hasLearnedCosts_;                    // Vrai si un coût appris diffère du coût fixe.
+    PlannerMode mode_;                        // Algorithme utilisé lorsque des segments sont bloqués.
+    uint8_t goal_;                            // Arrivée de l'état incrémental (NO_NODE si invalide).
+    uint8_t g_[SIZE];                         // Coût vers l'arrivée lors de la dernière expansion.
+    uint8_t rhs_[SIZE];                       // Coût vers l'arrivée prévu à partir des voisins.
+    uint32_t openNodes_;                      // File de priorité: un bit par point incohérent.
 };
 
 #endif
\ No newline at end of file
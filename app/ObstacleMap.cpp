@@ -0,0 +1,137 @@
+/**
+ * @file ObstacleMap.cpp
+ * @brief Implémentation de la classe ObstacleMap.
+ *
+ * Ce fichier implémente la carte des obstacles en mémoire externe. Organisation de la mémoire à
+ * partir de OBSTACLE_MAP_ADDRESS: marque (1 octet), signature de la carte (1 octet), compteur de
+ * parcours (2 octets), puis une entrée ObstacleRecord par segment.
+ */
+#include "ObstacleMap.hpp"
+
+static const uint16_t MAGIC_ADDRESS = OBSTACLE_MAP_ADDRESS;
+static const uint16_t SIGNATURE_ADDRESS = OBSTACLE_MAP_ADDRESS + 1;
+static const uint16_t RUN_ADDRESS = OBSTACLE_MAP_ADDRESS + 2;
+static const uint16_t RECORDS_ADDRESS = RUN_ADDRESS + sizeof(uint16_t);
+
+// Adresse de l'entrée d'un segment
+static inline uint16_t getRecordAddress(uint8_t edge)
+{
+    return RECORDS_ADDRESS + edge * sizeof(ObstacleRecord);
+}
+
+// Indique si un segment touche l'une des destinations
+static bool isDestinationEdge(uint8_t edge, const Coordinate destinations[], uint8_t count)
+{
+    uint8_t node1 = pgm_read_byte(&edgeList.edges[edge].node1);
+    uint8_t node2 = pgm_read_byte(&edgeList.edges[edge].node2);
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        if (!isOnMap(destinations[i]))
+            continue;
+        uint8_t node = toNodeIndex(destinations[i]);
+        if (node == node1 || node == node2)
+            return true;
+    }
+    return false;
+}
+
+ObstacleMap::ObstacleMap() : run_(0)
+{
+    load();
+}
+
+void ObstacleMap::load()
+{
+    uint8_t magic;
+    uint8_t signature;
+    memory_.read(MAGIC_ADDRESS, &magic);
+    memory_.read(SIGNATURE_ADDRESS, &signature);
+    // Mémoire vierge ou identifiants de segments d'une autre carte
+    if (magic != OBSTACLE_MAP_MAGIC || signature != getMapSignature())
+    {
+        clear();
+        return;
+    }
+    memory_.read(RUN_ADDRESS, reinterpret_cast<uint8_t *>(&run_), sizeof(run_));
+}
+
+void ObstacleMap::clear()
+{
+    ObstacleRecord empty = {0, 0};
+    for (uint8_t edge = 0; edge < N_EDGES; ++edge)
+        writeRecord(edge, empty);
+    run_ = 0;
+    writeRun();
+    memory_.write(SIGNATURE_ADDRESS, getMapSignature());
+    memory_.write(MAGIC_ADDRESS, OBSTACLE_MAP_MAGIC); // Écrite en dernier: la carte est complète
+}
+
+void ObstacleMap::startRun()
+{
+    run_++;
+    writeRun();
+}
+
+void ObstacleMap::recordObstacle(const Coordinate &point)
+{
+    if (!isOnMap(point))
+        return;
+    uint8_t node = toNodeIndex(point);
+    uint8_t lastArc = pgm_read_byte(&adjacency.offsets[node + 1]);
+    for (uint8_t arc = pgm_read_byte(&adjacency.offsets[node]); arc < lastArc; ++arc)
+        recordEdge(pgm_read_byte(&adjacency.arcs[arc].edge));
+}
+
+void ObstacleMap::applyTo(Dijkstra &dijkstra, const Coordinate &start, const Coordinate destinations[], uint8_t count)
+{
+    for (uint8_t edge = 0; edge < N_EDGES; ++edge)
+    {
+        // Un obstacle mémorisé autour d'une destination est réessayé: il a pu être retiré depuis
+        if (isActive(readRecord(edge)) && !isDestinationEdge(edge, destinations, count))
+            dijkstra.blockEdge(edge);
+    }
+    // Les obstacles mémorisés ne doivent jamais rendre une destination inaccessible
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        if (!dijkstra.isReachable(start, destinations[i]))
+        {
+            dijkstra.resetObstacles();
+            return;
+        }
+    }
+}
+
+void ObstacleMap::recordEdge(uint8_t edge)
+{
+    ObstacleRecord record = readRecord(edge);
+    // Un obstacle expiré puis revu repart de zéro
+    if (!isActive(record))
+        record.confidence = 0;
+    if (record.confidence < OBSTACLE_MAX_CONFIDENCE)
+        record.confidence++;
+    record.lastSeenRun = run_;
+    writeRecord(edge, record);
+}
+
+bool ObstacleMap::isActive(const ObstacleRecord &record) const
+{
+    uint16_t age = run_ - record.lastSeenRun;
+    return record.confidence != 0 && age < static_cast<uint16_t>(record.confidence) * OBSTACLE_RUNS_PER_CONFIDENCE;
+}
+
+ObstacleRecord ObstacleMap::readRecord(uint8_t edge)
+{
+    ObstacleRecord record;
+    memory_.read(getRecordAddress(edge), reinterpret_cast<uint8_t *>(&record), sizeof(record));
+    return record;
+}
+
+void ObstacleMap::writeRecord(uint8_t edge, ObstacleRecord &record)
+{
+    memory_.write(getRecordAddress(edge), reinterpret_cast<uint8_t *>(&record), sizeof(record));
+}
+
+void ObstacleMap::writeRun()
+{
+    memory_.write(RUN_ADDRESS, reinterpret_cast<uint8_t *>(&run_), sizeof(run_));
+}
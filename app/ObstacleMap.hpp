@@ -0,0 +1,115 @@
+/**
+ * @file ObstacleMap.h
+ * @brief Définition de la classe ObstacleMap pour la mémorisation des obstacles.
+ *
+ * La classe ObstacleMap conserve en mémoire externe (EEPROM 24CXXX) les segments où des obstacles
+ * ont été détectés, afin que le robot les évite dès la planification lors des parcours suivants,
+ * même après une mise hors tension.
+ */
+
+#ifndef OBSTACLE_MAP_H
+#define OBSTACLE_MAP_H
+
+#include "Memoire_24.hpp"
+#include "Dijkstra.hpp"
+#include "res/struct/ObstacleRecord.hpp"
+#include "res/consts.hpp"
+
+/**
+ * @class ObstacleMap
+ * @brief Carte des obstacles persistante.
+ *
+ * Chaque segment possède une entrée (ObstacleRecord) avec le numéro du dernier parcours où un
+ * obstacle y a été vu et une confiance qui augmente à chaque détection. Une entrée reste active
+ * pendant confiance x OBSTACLE_RUNS_PER_CONFIDENCE parcours, puis le segment est de nouveau
+ * essayé. La mémoire est reformatée si elle est vierge ou si la carte a changé.
+ */
+class ObstacleMap
+{
+public:
+    /**
+     * @brief Constructeur de ObstacleMap.
+     *
+     * Relit l'en-tête de la carte des obstacles en mémoire externe.
+     */
+    ObstacleMap();
+
+    /**
+     * @brief Destructeur par défaut de ObstacleMap.
+     */
+    ~ObstacleMap() = default;
+
+    /**
+     * @brief Relit l'en-tête en mémoire externe et reformate la carte si elle est invalide.
+     */
+    void load();
+
+    /**
+     * @brief Efface tous les obstacles mémorisés et remet le compteur de parcours à zéro.
+     */
+    void clear();
+
+    /**
+     * @brief Indique le début d'un nouveau parcours (incrémente le compteur de parcours).
+     */
+    void startRun();
+
+    /**
+     * @brief Mémorise un obstacle sur chaque segment qui touche un point.
+     * @param point Le point où l'obstacle a été détecté.
+     */
+    void recordObstacle(const Coordinate &point);
+
+    /**
+     * @brief Bloque dans Dijkstra les segments dont l'obstacle est encore actif.
+     *
+     * La carte sert à éviter les obstacles, jamais à refuser une destination: les segments qui
+     * touchent une destination ne sont pas bloqués, et si une destination reste inaccessible, aucun
+     * segment mémorisé n'est bloqué pour ce parcours. Un obstacle toujours présent est alors détecté
+     * en route.
+     *
+     * @param dijkstra L'algorithme de planification à mettre à jour.
+     * @param start Le point de départ du robot.
+     * @param destinations Les destinations du parcours.
+     * @param count Le nombre de destinations.
+     */
+    void applyTo(Dijkstra &dijkstra, const Coordinate &start, const Coordinate destinations[], uint8_t count);
+
+private:
+    /**
+     * @brief Mémorise un obstacle sur un segment.
+     * @param edge Identifiant du segment.
+     */
+    void recordEdge(uint8_t edge);
+
+    /**
+     * @brief Indique si l'obstacle d'une entrée doit encore être évité.
+     * @param record L'entrée de la carte des obstacles.
+     * @return true si le segment doit être bloqué.
+     */
+    bool isActive(const ObstacleRecord &record) const;
+
+    /**
+     * @brief Lit l'entrée d'un segment en mémoire externe.
+     * @param edge Identifiant du segment.
+     * @return ObstacleRecord L'entrée du segment.
+     */
+    ObstacleRecord readRecord(uint8_t edge);
+
+    /**
+     * @brief Écrit l'entrée d'un segment en mémoire externe.
+     * @param edge Identifiant du segment.
+     * @param record L'entrée à écrire.
+     */
+    void writeRecord(uint8_t edge, ObstacleRecord &record);
+
+    /**
+     * @brief Écrit le compteur de parcours en mémoire externe.
+     */
+    void writeRun();
+
+    Memoire24CXXX memory_; // Mémoire externe qui contient la carte des obstacles.
+    uint16_t run_;         // Numéro du parcours en cours.
+};
+
+#endif // OBSTACLE_MAP_H
@@ -18,56 +18,102 @@
 #include "Robot.hpp"
 
 Robot *gRobot;
-volatile uint8_t gNCyclesToBlinkedLedPassed = 0;
-volatile bool gIsLedGreenBlinked = false;
 
-ISR(TIMER1_COMPA_vect)
+// Orientation de la carte située à gauche d'une direction de navigation
+static Cardinal getLeftCardinal(const CardinalDirection &direction)
 {
-    // logique clignotement des led
-    if (gRobot->getMode() == RobotMode::IDENTIFY_CORNER)
+    switch (direction)
     {
-        gNCyclesToBlinkedLedPassed++;
-        if (gNCyclesToBlinkedLedPassed == N_CYCLES_TO_BLINK_LED)
-        {
-            if (gIsLedGreenBlinked)
-                gRobot->turnOffLed();
-            else
-                gRobot->setLedColorOn(LedColor::GREEN);
-            gNCyclesToBlinkedLedPassed = 0;
-            gIsLedGreenBlinked = !gIsLedGreenBlinked;
-        }
+    case CardinalDirection::EAST:
+        return Cardinal::NORTH;
+    case CardinalDirection::SOUTH:
+        return Cardinal::EAST;
+    case CardinalDirection::WEST:
+        return Cardinal::SOUTH;
+    default:
+        return Cardinal::WEST;
     }
+}
 
-    if (gRobot->getChrono().isTimerExpired())
+ISR(TIMER0_OVF_vect)
+{
+    if (gRobot->getControlLoop().tick())
     {
-        gRobot->setIsChronoRunning(false);
-        if (gRobot->getMode() == RobotMode::IDENTIFY_CORNER)
-            gRobot->buildSchema('A');
-        if (gRobot->isGoForwardBeforeTakeDecision())
-            gRobot->setIsGoForwardBeforeTakeDecision(false);
+        gRobot->updateMotion();
+        gRobot->sampleButtons();
     }
 }
 
-Robot::Robot() : led_(&PORTB, &DDRB, PB1, PB0), lcm_(&DDRC, &PORTC), buttonMotherBoard_(&DDRD, &PIND, PD2, ButtonMode::PULL_DOWN),
+ISR(PCINT0_vect)
+{
+    gRobot->captureLineTransition();
+}
+
+// Reveil de veille profonde par les boutons: le traitement est fait par l'anti-rebond
+EMPTY_INTERRUPT(PCINT1_vect);
+EMPTY_INTERRUPT(PCINT3_vect);
+
+// Arme le reveil par changement de broche des boutons (PD2, PD3 et PB2)
+static void enableButtonWake()
+{
+    PCMSK3 |= (1 << PCINT26) | (1 << PCINT27);
+    PCMSK1 |= (1 << PCINT10);
+    PCIFR = (1 << PCIF1) | (1 << PCIF3);
+    PCICR |= (1 << PCIE1) | (1 << PCIE3);
+}
+
+static void disableButtonWake()
+{
+    PCICR &= ~((1 << PCIE1) | (1 << PCIE3));
+}
+
+ISR(TIMER1_OVF_vect)
+{
+    gRobot->getClock().handleOverflow();
+}
+
+ISR(TIMER1_COMPA_vect)
+{
+    gRobot->tickTimers();
+}
+
+Robot::Robot() : led_(&PORTB, &DDRB, PB1, PB0), chrono_(&timerWheel_, &clock_, onChronoExpired, this), lcm_(&DDRC, &PORTC), buttonMotherBoard_(&DDRD, &PIND, PD2, ButtonMode::PULL_DOWN),
                  buttonValidation_(&DDRD, &PIND, PD3, ButtonMode::PULL_UP), buttonSelection_(&DDRB, &PINB, PB2, ButtonMode::PULL_UP),
-                 linePosition_(LinePosition::UNDEFINED), isChronoRunning_(false), isFirstChronoRunning_(true), isInitialCornerFound_(false),
+                 buttonDebouncer_(&inputEvents_), lastWakeTick_(0), scheduler_(&controlLoop_), lineSensor_(&controlLoop_), linePid_(LINE_PID_KP, LINE_PID_KI, LINE_PID_KD, LINE_PID_INTEGRAL_LIMIT),
+                 linePosition_(LinePosition::UNDEFINED), isChronoRunning_(false), isChronoStepPending_(false), isFirstChronoRunning_(true), isInitialCornerFound_(false),
                  isReturnToIntialaCorner_(false), isObstacleDetected_(false), isGoForwardBeforeTakeDecision_(false), mode_(RobotMode::UNDEFINED),
-                 initialDirection_(CardinalDirection::SOUTH), isRoadEnd_(false)
+                 initialDirection_(CardinalDirection::SOUTH), isAtNode_(true), isRoadEnd_(false),
+                 segmentTimeoutMs_(SEGMENT_UNIT_TIME_MS), measuredSegmentTimeMs_(0),
+                 blinkColor_(LedColor::GREEN), nBlinks_(0), isIdentifyLedOn_(false)
 {
     gRobot = this;
+    buttonDebouncer_.addButton(&buttonMotherBoard_, static_cast<uint8_t>(InputEvent::MOTHER_BOARD_PRESSED));
+    buttonDebouncer_.addButton(&buttonValidation_, static_cast<uint8_t>(InputEvent::VALIDATION_PRESSED));
+    buttonDebouncer_.addButton(&buttonSelection_, static_cast<uint8_t>(InputEvent::SELECTION_PRESSED));
+    identifyBlinkTimer_ = timerWheel_.create(onIdentifyBlink, this);
+    nav_.enableControlTick();
+    lineSensor_.enableTransitionCapture();
+    clock_.enable();
     currentSchema_ = {};
     initialPoint_ = {1, 1};
     currentPoint_ = {1, 1};
     finalPoint_ = {1, 1};
 }
 
-void Robot::wait(uint16_t delayMs)
+void Robot::wait(const ControlTicks &duration)
 {
-    while (delayMs > 0)
-    {
-        _delay_ms(MILLI_SECOND);
-        delayMs--;
-    }
+    scheduler_.waitFor(duration);
+}
+
+void Robot::runTasks()
+{
+    scheduler_.runPending();
+}
+
+void Robot::finishTasks()
+{
+    while (scheduler_.hasTasks())
+        scheduler_.runPending();
 }
 
 void Robot::setIsChronoRunning(bool value)
@@ -75,9 +121,49 @@ void Robot::setIsChronoRunning(bool value)
     isChronoRunning_ = value;
 }
 
-Chrono &Robot::getChrono()
+MonotonicClock &Robot::getClock()
+{
+    return clock_;
+}
+
+void Robot::tickTimers()
+{
+    clock_.scheduleNextTick();
+    timerWheel_.tick();
+}
+
+void Robot::onChronoExpired(void *context)
+{
+    Robot *robot = static_cast<Robot *>(context);
+    robot->isChronoRunning_ = false;
+    if (robot->mode_ == RobotMode::IDENTIFY_CORNER)
+        robot->isChronoStepPending_ = true;
+    robot->isGoForwardBeforeTakeDecision_ = false;
+}
+
+void Robot::onIdentifyBlink(void *context)
+{
+    Robot *robot = static_cast<Robot *>(context);
+    if (robot->isIdentifyLedOn_)
+        robot->turnOffLed();
+    else
+        robot->setLedColorOn(LedColor::GREEN);
+    robot->isIdentifyLedOn_ = !robot->isIdentifyLedOn_;
+}
+
+ControlLoop &Robot::getControlLoop()
+{
+    return controlLoop_;
+}
+
+void Robot::updateMotion()
 {
-    return chrono_;
+    nav_.updateProfile();
+}
+
+void Robot::captureLineTransition()
+{
+    lineSensor_.captureTransition();
 }
 
 bool Robot::isGoForwardBeforeTakeDecision()
@@ -95,24 +181,65 @@ CornerNode &Robot::getCorner()
     return initialCorner_;
 }
 
-bool Robot::isButtonMotherBoardPressed()
+void Robot::sleepUntilInput()
+{
+    cli();
+    if (!inputEvents_.isEmpty())
+    {
+        sei();
+        return;
+    }
+    // la veille profonde arrete le timer 0: roues, taches et anti-rebond doivent etre au repos
+    uint16_t sinceWake = controlLoop_.getTickCount() - lastWakeTick_;
+    if (sinceWake >= ControlTicks(DELAY_BEFORE_POWER_DOWN_MS).count() && !scheduler_.hasTasks() && !timerWheel_.hasActiveTimers() && buttonDebouncer_.isReleased() && nav_.isStopped())
+    {
+        enableButtonWake();
+        PowerManager::sleep(SleepMode::POWER_DOWN);
+        disableButtonWake();
+        lastWakeTick_ = controlLoop_.getTickCount();
+    }
+    else
+        PowerManager::sleep(SleepMode::IDLE);
+}
+
+void Robot::suspendUnusedPeripherals()
+{
+    power_.disableAdc();
+    if (!scheduler_.hasTasks())
+        power_.disableTimer2();
+}
+
+void Robot::resumePeripherals()
 {
-    return buttonMotherBoard_.isPressed();
+    power_.enableAdc();
+    power_.enableTimer2();
 }
 
-bool Robot::isButtonValidationPressed()
+EventQueue &Robot::getInputEvents()
 {
-    return buttonValidation_.isPressed();
+    return inputEvents_;
+}
+
+void Robot::discardInputEvents()
+{
+    while (!buttonDebouncer_.isReleased())
+    {
+        controlLoop_.waitForNextPeriod();
+        scheduler_.runPending();
+    }
+    inputEvents_.clear();
 }
 
-bool Robot::isButtonSelectionPressed()
+void Robot::sampleButtons()
 {
-    return buttonSelection_.isPressed();
+    buttonDebouncer_.update();
 }
 
-void Robot::blinkLed(const LedColor &color, uint32_t duration)
+void Robot::blinkLed(const LedColor &color, const Milliseconds &duration)
 {
-    led_.blinkLed(color, duration);
+    blinkColor_ = color;
+    nBlinks_ = duration.count() / (2 * DELAY_MS_PER_BLINK);
+    scheduler_.start(blinkTask, this);
 }
 
 void Robot::setLedColorOn(const LedColor &color)
@@ -125,11 +252,6 @@ void Robot::turnOffLed()
     led_.turnOffLed();
 }
 
-void Robot::blinkLed(const LedColor &ledColor, double frequency)
-{
-    led_.blinkLed(ledColor, frequency);
-}
-
 void Robot::playSong(uint8_t noteNumber)
 {
     sound_.play(noteNumber);
@@ -137,7 +259,7 @@ void Robot::playSong(uint8_t noteNumber)
 
 void Robot::playPiratesDesCaraibesSong()
 {
-    sound_.playPiratesDesCaraibesSong();
+    scheduler_.start(piratesSongTask, this);
 }
 
 void Robot::stopSong()
@@ -145,7 +267,7 @@ void Robot::stopSong()
     sound_.stop();
 }
 
-void Robot::moveTo(const Direction &direction, const double speedLeft, const double speedRight)
+void Robot::moveTo(const Direction &direction, const DutyCycle &speedLeft, const DutyCycle &speedRight)
 {
     nav_.moveWheelToDirection(direction, speedLeft, speedRight);
 }
@@ -153,25 +275,37 @@ void Robot::moveTo(const Direction &direction, const double speedLeft, const dou
 void Robot::turn90Degre(const Direction &direction)
 {
     stopEngine();
-    _delay_ms(DELAY_STOP_BEFORE_TURN_MS);
-    nav_.turn90Degre(direction);
-    findLine(direction);
+    wait(DELAY_STOP_BEFORE_TURN_MS);
+    spinToLine(direction, 1, TURN_90_TIMEOUT_MS);
 }
 
-void Robot::turn180Degre(const Direction &direction)
+void Robot::turn180Degre(const Direction &direction, uint8_t nLinesToCross)
 {
     stopEngine();
-    _delay_ms(DELAY_STOP_BEFORE_TURN_MS);
-    nav_.turn180Degre(direction);
-    findLine(direction);
+    wait(DELAY_STOP_BEFORE_TURN_MS);
+    spinToLine(direction, nLinesToCross, TURN_180_TIMEOUT_MS);
 }
 
-void Robot::turn360Degre()
+void Robot::arcTurn90Degre(const Direction &direction)
 {
-    stopEngine();
-    _delay_ms(DELAY_STOP_BEFORE_TURN_MS);
-    nav_.turn360Degre();
-    findLine(Direction::LEFT);
+    nav_.arcTurn(direction);
+    // quitter d'abord la ligne courante, puis tourner jusqu'a retrouver la nouvelle ligne
+    wait(DELAY_ARC_LEAVE_LINE_MS);
+    constexpr uint16_t nPeriods = ControlPeriods(ARC_TURN_TIMEOUT_MS).count() - ControlPeriods(DELAY_ARC_LEAVE_LINE_MS).count();
+    linePosition_ = lineSensor_.determineLinePosition();
+    for (uint16_t period = 0; linePosition_ != LinePosition::CENTER && linePosition_ != LinePosition::RIGHT && linePosition_ != LinePosition::LEFT; period++)
+    {
+        if (period >= nPeriods)
+        {
+            spinToLine(direction, 1, TURN_90_TIMEOUT_MS);
+            return;
+        }
+        controlLoop_.waitForNextPeriod();
+        linePosition_ = lineSensor_.determineLinePosition();
+        scheduler_.runPending();
+    }
+    linePid_.reset();
+    lineSensor_.clearTransitions();
 }
 
 void Robot::stopEngine()
@@ -189,45 +323,45 @@ void Robot::stopRobot()
 
 void Robot::followLine()
 {
+    controlLoop_.waitForNextPeriod();
     linePosition_ = lineSensor_.determineLinePosition();
-    switch (linePosition_)
-    {
-    case LinePosition::MOST_LEFT:
-        moveTo(Direction::FORWARD, SPEED_TO_MUST_ADJUST_MS, SPEED);
-        break;
-    case LinePosition::LEFT:
-        moveTo(Direction::FORWARD, SPEED_TO_ADJUST_MS, SPEED);
-        break;
-    case LinePosition::RIGHT:
-        moveTo(Direction::FORWARD, SPEED, SPEED_TO_ADJUST_MS);
-        break;
-    case LinePosition::MOST_RIGHT:
-        moveTo(Direction::FORWARD, SPEED, SPEED_TO_MUST_ADJUST_MS);
-        break;
-    case LinePosition::CROSS_DETECTED:
-    case LinePosition::CROSS_LEFT_DETECTED:
-    case LinePosition::CROSS_RIGHT_DETECTED:
-    case LinePosition::LOST:
-    case LinePosition::CENTER:
-        moveTo(Direction::FORWARD, SPEED, SPEED);
-        break;
-    default:
-        break;
-    }
-    _delay_ms(DELAY_CORRECTION_MS);
+    // ligne a droite (position positive): la roue gauche accelere et la droite ralentit
+    int16_t correction = linePid_.update(lineSensor_.estimateLinePosition());
+    if (correction > DUTY_CYCLE_MAX)
+        correction = DUTY_CYCLE_MAX;
+    else if (correction < -DUTY_CYCLE_MAX)
+        correction = -DUTY_CYCLE_MAX;
+    int16_t leftDuty = static_cast<int16_t>(LINE_FOLLOW_CRUISE_DUTY.value) + correction;
+    int16_t rightDuty = static_cast<int16_t>(LINE_FOLLOW_CRUISE_DUTY.value) - correction;
+    moveTo(Direction::FORWARD, clampDutyCycle(leftDuty), clampDutyCycle(rightDuty));
+    scheduler_.runPending();
 }
 
-void Robot::findLine(const Direction &direction)
+void Robot::spinToLine(const Direction &direction, uint8_t nLinesToCross, const ControlPeriods &timeout)
 {
-    linePosition_ = lineSensor_.determineLinePosition();
-    while (linePosition_ != LinePosition::CENTER && linePosition_ != LinePosition::RIGHT && linePosition_ != LinePosition::LEFT)
+    nav_.spin(direction);
+    // une ligne n'est comptee qu'apres que la precedente a quitte tous les capteurs: la ligne de
+    // depart, meme sous S2 ou S4, peut passer sous le capteur central au debut de la rotation
+    bool isLineCleared = lineSensor_.readLineSensorsState() == 0;
+    uint8_t nLinesCrossed = 0;
+    for (uint16_t period = 0; period < timeout.count(); period++)
     {
-        moveTo(direction, SPEED_TO_FIND_LINE, SPEED_TO_FIND_LINE);
-        _delay_ms(DELAY_FIND_LINE_MS);
-        linePosition_ = lineSensor_.determineLinePosition();
-        stopEngine();
+        controlLoop_.waitForNextPeriod();
+        if (lineSensor_.readLineSensorsState() == 0)
+            isLineCleared = true;
+        else if (isLineCleared && lineSensor_.isLineOnCenter())
+        {
+            isLineCleared = false;
+            if (++nLinesCrossed == nLinesToCross)
+                break;
+        }
+        scheduler_.runPending();
     }
-    _delay_ms(DELAY_AFTER_FIND_LINE_MS);
+    // arret sans rampe pour rester sur la ligne visee
+    nav_.brake();
+    linePid_.reset();
+    lineSensor_.clearTransitions();
+    linePosition_ = lineSensor_.determineLinePosition();
 }
 
 bool Robot::isInitialCornerFound() const
@@ -279,15 +413,17 @@ LinePosition Robot::getLinePosition()
 
 void Robot::searchInitialCorner()
 {
+    if (!timerWheel_.isActive(identifyBlinkTimer_))
+        timerWheel_.start(identifyBlinkTimer_, IDENTIFY_BLINK_PERIOD_MS, IDENTIFY_BLINK_PERIOD_MS);
     if (!isChronoRunning_)
     {
         if (isFirstChronoRunning_)
         {
-            chrono_.start(DELAY_TO_TAKE_HALF_SEGMENT_MS); // ajuster parfois
+            chrono_.start(DELAY_TO_TAKE_HALF_SEGMENT_S); // ajuster parfois
             isFirstChronoRunning_ = false;
         }
         else
-            chrono_.start(DELAY_TO_TAKE_SEGMENT_MS); // ajuster parfois
+            chrono_.start(DELAY_TO_TAKE_SEGMENT_S); // ajuster parfois
         isChronoRunning_ = true;
     }
 
@@ -303,11 +439,18 @@ void Robot::searchInitialCorner()
     if (!isInitialCornerFound_)
     {
         followLine();
-        linePosition_ = lineSensor_.determineLinePosition();
+        // l'etape du chrono expire est ajoutee ici plutot que dans l'interruption
+        if (isChronoStepPending_)
+        {
+            isChronoStepPending_ = false;
+            buildSchema('A');
+        }
+        // une seule etape par croisement franchi, meme s'il reste sous les capteurs plusieurs periodes
+        LinePosition intersection = lineSensor_.takeIntersection();
 
-        if (linePosition_ == LinePosition::CROSS_LEFT_DETECTED)
+        if (intersection == LinePosition::CROSS_LEFT_DETECTED)
             buildSchema('G');
-        else if (linePosition_ == LinePosition::CROSS_RIGHT_DETECTED)
+        else if (intersection == LinePosition::CROSS_RIGHT_DETECTED)
             buildSchema('D');
         else if (linePosition_ == LinePosition::LOST)
         {
@@ -322,11 +465,11 @@ void Robot::searchInitialCorner()
             {
                 // si jamais on arrive a lost et aucune sequence n'est detecté on fait demi tour
                 // et on recommence
-                // chrono_.stop();
-                chrono_.reset();
+                chrono_.stop();
                 forwardBeforeTurn();
                 isChronoRunning_ = false;
                 isFirstChronoRunning_ = true;
+                isChronoStepPending_ = false;
                 goBackToInitialCorner(Direction::LEFT, Direction::RIGHT);
                 currentSchema_ = {};
                 lcm_.clear();
@@ -339,26 +482,26 @@ void Robot::searchInitialCorner()
 void Robot::forwardBeforeTurn()
 {
     moveTo(Direction::FORWARD, SPEED, SPEED);
-    _delay_ms(DELAY_BEFORE_TURN_MS);
+    wait(DELAY_BEFORE_TURN_MS);
 }
 
 void Robot::goBackToInitialCorner(const Direction &directionToTurnFirst, const Direction &directionToTurnSecond)
 {
     stopEngine();
-    _delay_ms(DELAY_TO_STOP_ENGINE_FOR_BACK_MS);
-    turn180Degre(directionToTurnFirst);
+    wait(DELAY_TO_STOP_ENGINE_FOR_BACK_MS);
+    turn180Degre(directionToTurnFirst, 1);
     linePosition_ = lineSensor_.determineLinePosition();
     while (linePosition_ != LinePosition::LOST)
     {
         if (linePosition_ == LinePosition::CROSS_LEFT_DETECTED || linePosition_ == LinePosition::CROSS_RIGHT_DETECTED) // pour palier a certains cas
         {
             moveTo(Direction::FORWARD, SPEED, SPEED);
-            _delay_ms(DELAY_TO_SKIP_CROSS_NOT_NECESSARY_MS);
+            wait(DELAY_TO_SKIP_CROSS_NOT_NECESSARY_MS);
         }
         followLine();
     }
     forwardBeforeTurn();
-    turn180Degre(directionToTurnSecond);
+    turn180Degre(directionToTurnSecond, 1);
 }
 
 void Robot::searchInitialCornerAndReturn()
@@ -368,9 +511,10 @@ void Robot::searchInitialCornerAndReturn()
     else
     {
         chrono_.stop();
+        timerWheel_.stop(identifyBlinkTimer_);
         stopEngine();
         playSong(NOTE_IF_CORNER_FOUND);
-        _delay_ms(DELAY_TO_PLAY_SONG_MS);
+        wait(DELAY_TO_PLAY_SONG_MS);
         stopSong();
         setLedColorOn(LedColor::GREEN);
         goBackToInitialCorner(initialCorner_.directionToTurnFirst, initialCorner_.directionToTurnSecond);
@@ -450,32 +594,51 @@ const Coordinate &Robot::getFinalPoint() const
     return finalPoint_;
 }
 
+const CardinalDirection &Robot::getInitialDirection() const
+{
+    return initialDirection_;
+}
+
 void Robot::resetFinalPoint()
 {
     finalPoint_ = {1, 1};
 }
 
+void Robot::setFinalPoint(const Coordinate &finalPoint)
+{
+    finalPoint_ = finalPoint;
+}
+
 void Robot::setRoad(const RoadSchema &roadSchema)
 {
-    roadSchema_.size = roadSchema.size + 2;
-    roadSchema_.road[0] = CardinalDirection::START;
+    // regroupe les directions identiques consecutives en lignes droites
+    roadPlan_.size = 0;
     for (uint8_t i = 0; i < roadSchema.size; i++)
-        roadSchema_.road[i + 1] = roadSchema.road[i];
-    roadSchema_.road[roadSchema_.size - 1] = CardinalDirection::END;
-    currentIndexRoad_ = 0;
+    {
+        if (roadPlan_.size != 0 && roadPlan_.primitives[roadPlan_.size - 1].direction == roadSchema.road[i])
+            roadPlan_.primitives[roadPlan_.size - 1].nIntersections++;
+        else
+            roadPlan_.primitives[roadPlan_.size++] = {roadSchema.road[i], 1};
+    }
+    currentPrimitive_ = 0;
+    nIntersectionsPassed_ = 0;
+    isRoadStarted_ = false;
     isRoadEnd_ = false;
     isObstacleDetected_ = false;
 }
 
 void Robot::turnWithDecision(const CardinalDirection &dir1, const CardinalDirection &dir2)
 {
+    // pendant un demi-tour par la gauche a une intersection, la route de gauche est rencontree avant
+    // la ligne visee; entre deux points (recul apres un obstacle), seule la ligne parcourue l'est
+    uint8_t nLinesToCrossForHalfTurn = (isAtNode_ && hasMapRoad(currentPoint_, getLeftCardinal(dir1))) ? 2 : 1;
     switch (dir1)
     {
     case CardinalDirection::EAST:
         if (dir2 == CardinalDirection::NORTH)
             turn90Degre(Direction::LEFT);
         else if (dir2 == CardinalDirection::WEST)
-            turn180Degre(Direction::LEFT);
+            turn180Degre(Direction::LEFT, nLinesToCrossForHalfTurn);
         else if (dir2 == CardinalDirection::SOUTH)
             turn90Degre(Direction::RIGHT);
         break;
@@ -485,19 +648,19 @@ void Robot::turnWithDecision(const CardinalDirection &dir1, const CardinalDirect
         else if (dir2 == CardinalDirection::WEST)
             turn90Degre(Direction::LEFT);
         else if (dir2 == CardinalDirection::SOUTH)
-            turn180Degre(Direction::LEFT);
+            turn180Degre(Direction::LEFT, nLinesToCrossForHalfTurn);
         break;
     case CardinalDirection::WEST:
         if (dir2 == CardinalDirection::NORTH)
             turn90Degre(Direction::RIGHT);
         else if (dir2 == CardinalDirection::EAST)
-            turn180Degre(Direction::LEFT);
+            turn180Degre(Direction::LEFT, nLinesToCrossForHalfTurn);
         else if (dir2 == CardinalDirection::SOUTH)
             turn90Degre(Direction::LEFT);
         break;
     case CardinalDirection::SOUTH:
         if (dir2 == CardinalDirection::NORTH)
-            turn180Degre(Direction::LEFT);
+            turn180Degre(Direction::LEFT, nLinesToCrossForHalfTurn);
         else if (dir2 == CardinalDirection::WEST)
             turn90Degre(Direction::RIGHT);
         else if (dir2 == CardinalDirection::EAST)
@@ -531,9 +694,22 @@ void Robot::updateCurrentPoint()
 
 Coordinate Robot::getNextPoint() const
 {
-    Coordinate nextPoint = currentPoint_;
+    return movePoint(currentPoint_, currentDirection_);
+}
 
-    switch (currentDirection_)
+Coordinate Robot::getUpcomingPoint() const
+{
+    // le depart (virage sur place) et l'arrivee ne parcourent aucun segment
+    if (!isRoadStarted_ || currentPrimitive_ >= roadPlan_.size)
+        return currentPoint_;
+    return movePoint(currentPoint_, roadPlan_.primitives[currentPrimitive_].direction);
+}
+
+Coordinate Robot::movePoint(const Coordinate &point, const CardinalDirection &direction)
+{
+    Coordinate nextPoint = point;
+
+    switch (direction)
     {
     case CardinalDirection::EAST:
         nextPoint.column++;
@@ -558,15 +734,16 @@ void Robot::endRoadRoutine()
     lcm_.clear();
     initialPoint_ = finalPoint_;
     currentPoint_ = finalPoint_;
+    isAtNode_ = true;
     resetFinalPoint();
-    currentIndexRoad_ = 0;
+    currentPrimitive_ = 0;
     // a faire c'est que cela fausse l'algo
-    if (roadSchema_.road[roadSchema_.size - 2] != CardinalDirection::START)
-        initialDirection_ = roadSchema_.road[roadSchema_.size - 2];
+    if (roadPlan_.size != 0)
+        initialDirection_ = roadPlan_.primitives[roadPlan_.size - 1].direction;
     linePosition_ = lineSensor_.determineLinePosition();
     if (linePosition_ == LinePosition::LOST)
     {
-        turn180Degre(Direction::RIGHT);
+        turn180Degre(Direction::RIGHT, 1); // bout de ligne: seule la ligne parcourue est rencontree
         switch (initialDirection_)
         {
         case CardinalDirection::NORTH:
@@ -586,14 +763,26 @@ void Robot::endRoadRoutine()
         }
     }
     isRoadEnd_ = true;
-    for (uint8_t i = 0; i < N_TIME_TO_PLAY_SONG; i++)
-    {
-        playSong(NOTE_IF_CORNER_FOUND);
-        _delay_ms(DELAY_200_MS);
-        stopSong();
-        _delay_ms(DELAY_100_MS);
-    }
     stopRobot();
+    // la melodie continue pendant la saisie de la prochaine destination
+    scheduler_.start(endRoadSongTask, this);
+}
+
+void Robot::reportUnreachableDestination()
+{
+    stopRobot();
+    // le robot n'est pas arrive: il repart du point ou il s'est arrete
+    initialPoint_ = currentPoint_;
+    resetFinalPoint();
+    roadPlan_.size = 0;
+    currentPrimitive_ = 0;
+    isRoadEnd_ = true;
+    // l'avis d'obstacle efface l'ecran en se terminant
+    finishTasks();
+    lcm_.clear();
+    lcm_.write("Destination");
+    lcm_.write("inaccessible", LCM_FW_HALF_CH);
+    wait(DELAY_TO_DISPLAY_UNREACHABLE_MS);
 }
 
 void Robot::takeDecision()
@@ -602,104 +791,254 @@ void Robot::takeDecision()
     chrono_.stop();
     isChronoRunning_ = false;
     stopEngine();
-    _delay_ms(DELAY_AJUST_WHILE_RUNNING);
+    wait(DELAY_AJUST_WHILE_RUNNING);
     // tourner si les directions sont pas les memes
     if (currentDirection_ != nextDirection_)
         turnWithDecision(currentDirection_, nextDirection_);
 }
 void Robot::routineWhenObstacleDetected()
 {
-    lcm_.clear();
     stopEngine();
-    playSong(NOTE_IF_OBSTACLE_DETECTED);
-    lcm_.write("Poteau detecte");
-    _delay_ms(MIDDLE_DELAY_SPOT_DETECTED_MS);
-    lcm_.clear();
-    lcm_.write("Changement d'itineraire");
-    _delay_ms(MIDDLE_DELAY_SPOT_DETECTED_MS);
-    stopSong();
+    // les messages s'affichent pendant le recul et le calcul du nouveau trajet
+    scheduler_.start(obstacleNoticeTask, this);
     initialDirection_ = currentDirection_;
     isObstacleDetected_ = true;
-    lcm_.clear();
+}
+
+bool Robot::blinkTask(Task &task)
+{
+    Robot *robot = static_cast<Robot *>(task.context);
+    TASK_BEGIN(task);
+    for (task.counter = 0; task.counter < robot->nBlinks_; task.counter++)
+    {
+        robot->setLedColorOn(robot->blinkColor_);
+        TASK_SLEEP(task, Milliseconds(DELAY_MS_PER_BLINK));
+        robot->turnOffLed();
+        TASK_SLEEP(task, Milliseconds(DELAY_MS_PER_BLINK));
+    }
+    TASK_END(task);
+}
+
+bool Robot::piratesSongTask(Task &task)
+{
+    Robot *robot = static_cast<Robot *>(task.context);
+    TASK_BEGIN(task);
+    for (task.counter = 0; task.counter < Sound::getPiratesSongLength(); task.counter++)
+    {
+        robot->sound_.playNote(Sound::getPiratesSongNote(task.counter));
+        TASK_SLEEP(task, Milliseconds(Sound::getPiratesSongNote(task.counter).duration));
+        robot->stopSong();
+        TASK_SLEEP(task, Milliseconds(Sound::getPiratesSongNote(task.counter).duration));
+    }
+    TASK_END(task);
+}
+
+bool Robot::endRoadSongTask(Task &task)
+{
+    Robot *robot = static_cast<Robot *>(task.context);
+    TASK_BEGIN(task);
+    for (task.counter = 0; task.counter < N_TIME_TO_PLAY_SONG; task.counter++)
+    {
+        robot->playSong(NOTE_IF_CORNER_FOUND);
+        TASK_SLEEP(task, DELAY_200_MS);
+        robot->stopSong();
+        TASK_SLEEP(task, DELAY_100_MS);
+    }
+    TASK_END(task);
+}
+
+bool Robot::obstacleNoticeTask(Task &task)
+{
+    Robot *robot = static_cast<Robot *>(task.context);
+    TASK_BEGIN(task);
+    robot->lcm_.clear();
+    robot->playSong(NOTE_IF_OBSTACLE_DETECTED);
+    robot->lcm_.write("Poteau detecte");
+    TASK_SLEEP(task, MIDDLE_DELAY_SPOT_DETECTED_MS);
+    robot->lcm_.clear();
+    robot->lcm_.write("Changement d'itineraire");
+    TASK_SLEEP(task, MIDDLE_DELAY_SPOT_DETECTED_MS);
+    robot->stopSong();
+    robot->lcm_.clear();
+    TASK_END(task);
 }
 void Robot::followRoad()
 {
-    currentDirection_ = roadSchema_.road[currentIndexRoad_];
-    if (currentDirection_ == CardinalDirection::END)
+    measuredSegmentTimeMs_ = 0;
+    if (currentPrimitive_ >= roadPlan_.size)
+    {
         endRoadRoutine();
-    else
+        return;
+    }
+    const MotionPrimitive &primitive = roadPlan_.primitives[currentPrimitive_];
+    currentDirection_ = primitive.direction;
+    if (!isRoadStarted_)
+    {
+        turnWithDecision(initialDirection_, currentDirection_);
+        isRoadStarted_ = true;
+        return;
+    }
+
+    // il faut qu'il se positionne bien avant qu'on fasse la lecture ca peut nuire parfois !!!!!!
+    if (obstacleDetector_.isSpotDetected())
+    {
+        routineWhenObstacleDetected();
+        return;
+    }
+
+    // le segment n'est chronometre que si le chrono part de zero
+    bool isSegmentTimed = !isChronoRunning_;
+    if (!isChronoRunning_)
+    {
+        chrono_.start(Milliseconds(segmentTimeoutMs_)); // delai du segment calcule par Dijkstra
+        isChronoRunning_ = true;
+    }
+    // avance jusqu'a cross ou temps ecoulé
+    linePosition_ = lineSensor_.determineLinePosition();
+    while (!isCrossPosition(linePosition_) && isChronoRunning_)
     {
-        nextDirection_ = roadSchema_.road[currentIndexRoad_ + 1];
-        if (currentDirection_ == CardinalDirection::START)
+        followLine();
+        if (obstacleDetector_.isSpotDetected())
         {
-            turnWithDecision(initialDirection_, nextDirection_);
-            currentIndexRoad_++;
+            chrono_.stop();
+            isChronoRunning_ = false;
+            routineWhenObstacleDetected();
+            break;
         }
+    }
+    // temps du segment, seulement si l'intersection a ete vue avant l'expiration du delai
+    if (isSegmentTimed && !isObstacleDetected_ && isChronoRunning_)
+        measuredSegmentTimeMs_ = chrono_.getElapsedMs();
+
+    if (isObstacleDetected_)
+        backAwayFromObstacle();
+    else if (++nIntersectionsPassed_ < primitive.nIntersections)
+        passIntersection(); // ligne droite: aucun arret a cette intersection
+    else
+    {
+        nextDirection_ = (currentPrimitive_ + 1 < roadPlan_.size) ? roadPlan_.primitives[currentPrimitive_ + 1].direction
+                                                                  : CardinalDirection::END;
+        Direction turnDirection;
+        if (getQuarterTurn(currentDirection_, nextDirection_, turnDirection))
+            turnAtIntersection(turnDirection);
         else
-        {
-            // il faut qu'il se positionne bien avant qu'on fasse la lecture ca peut nuire parfois !!!!!!
-            if (obstacleDetector_.isSpotDetected())
-                routineWhenObstacleDetected();
-            else
-            {
-                if (!isChronoRunning_)
-                {
-                    chrono_.start(DELAY_TO_TAKE_SEGMENT_ROAD_MS); // il avance un peu d'ou il faut diminuer le temps TODO nbre magique
-                    isChronoRunning_ = true;
-                }
-                // avance jusqu'a cross ou temps ecoulé
-                linePosition_ = lineSensor_.determineLinePosition();
-                while (linePosition_ != LinePosition::CROSS_DETECTED && linePosition_ != LinePosition::CROSS_RIGHT_DETECTED &&
-                       linePosition_ != LinePosition::CROSS_LEFT_DETECTED && isChronoRunning_)
-                {
-                    followLine();
-                    if (obstacleDetector_.isSpotDetected())
-                    {
-                        chrono_.stop();
-                        isChronoRunning_ = false;
-                        routineWhenObstacleDetected();
-                        break;
-                    }
-                }
-                if (isObstacleDetected_)
-                {
-                    // faire une marche arriere
-                    moveTo(Direction::BACKWARD, SPEED, SPEED);
-                    _delay_ms(DELAY_TO_AJUST_IF_OBSTACLE_DETECTED);
-                    stopEngine();
-                }
-                else
-                {
-                    moveTo(Direction::FORWARD, SPEED, SPEED);
-                    _delay_ms(DELAY_AJUST_WHILE_RUNNING);
-                    stopEngine();
-                    _delay_ms(DELAY_AJUST_WHILE_RUNNING);
-                    // avancer avant de prendre decision avec le timer
-                    linePosition_ = lineSensor_.determineLinePosition();
-                    isGoForwardBeforeTakeDecision_ = true;
-                    chrono_.reset();
-                    if (!isChronoRunning_)
-                        chrono_.start(DELAY_BEFORE_TAKE_DECISION_S);
-                    else if (linePosition_ == LinePosition::LOST)
-                    {
-                        lcm_.clear();
-                        lcm_.write("LOST");
-                        chrono_.start(DELAY_BEFORE_TAKE_LOST_DECISION_S);
-                    }
-                    else
-                        chrono_.start(DELAY_BEFORE_TAKE_CROSS_DECISION_S);
-
-                    while (isGoForwardBeforeTakeDecision_)
-                        followLine();
-                    // prend decision
-                    updateCurrentPoint();
-                    takeDecision();
-                    currentIndexRoad_++;
-                }
-            }
-        }
+            stopAtIntersection();
+        currentPrimitive_++;
+        nIntersectionsPassed_ = 0;
+    }
+}
+
+void Robot::passIntersection()
+{
+    // traverse la croix sans s'arreter pour ne pas la compter une seconde fois
+    chrono_.start(CROSS_PASS_TIMEOUT_MS);
+    isChronoRunning_ = true;
+    bool isSpotDetected = false;
+    while (isCrossPosition(linePosition_) && isChronoRunning_ && !isSpotDetected)
+    {
+        followLine();
+        isSpotDetected = obstacleDetector_.isSpotDetected();
+    }
+    chrono_.stop();
+    isChronoRunning_ = false;
+    updateCurrentPoint();
+    isAtNode_ = true;
+    if (isSpotDetected)
+    {
+        routineWhenObstacleDetected();
+        backAwayFromObstacle();
+    }
+}
+
+void Robot::backAwayFromObstacle()
+{
+    // faire une marche arriere; le robot s'arrete entre le point courant et le poteau
+    moveTo(Direction::BACKWARD, SPEED, SPEED);
+    wait(DELAY_TO_AJUST_IF_OBSTACLE_DETECTED);
+    stopEngine();
+    isAtNode_ = false;
+}
+
+void Robot::stopAtIntersection()
+{
+    moveTo(Direction::FORWARD, SPEED, SPEED);
+    wait(DELAY_AJUST_WHILE_RUNNING);
+    stopEngine();
+    wait(DELAY_AJUST_WHILE_RUNNING);
+    // avancer avant de prendre decision avec le timer
+    linePosition_ = lineSensor_.determineLinePosition();
+    isGoForwardBeforeTakeDecision_ = true;
+    if (!isChronoRunning_)
+        chrono_.start(DELAY_BEFORE_TAKE_DECISION_S);
+    else if (linePosition_ == LinePosition::LOST)
+    {
+        lcm_.clear();
+        lcm_.write("LOST");
+        chrono_.start(DELAY_BEFORE_TAKE_LOST_DECISION_S);
+    }
+    else
+        chrono_.start(DELAY_BEFORE_TAKE_CROSS_DECISION_S);
+
+    while (isGoForwardBeforeTakeDecision_)
+        followLine();
+    // prend decision
+    updateCurrentPoint();
+    isAtNode_ = true;
+    takeDecision();
+}
+
+void Robot::turnAtIntersection(const Direction &direction)
+{
+    // avancer sans s'arreter jusqu'a ce que les roues approchent de la croix
+    isGoForwardBeforeTakeDecision_ = true;
+    chrono_.start(DELAY_BEFORE_ARC_TURN_S);
+    isChronoRunning_ = true;
+    while (isGoForwardBeforeTakeDecision_)
+        followLine();
+    chrono_.stop();
+    isChronoRunning_ = false;
+    updateCurrentPoint();
+    isAtNode_ = true;
+    arcTurn90Degre(direction);
+}
+
+bool Robot::getQuarterTurn(const CardinalDirection &from, const CardinalDirection &to, Direction &direction)
+{
+    switch (from)
+    {
+    case CardinalDirection::NORTH:
+        direction = (to == CardinalDirection::EAST) ? Direction::RIGHT : Direction::LEFT;
+        return to == CardinalDirection::EAST || to == CardinalDirection::WEST;
+    case CardinalDirection::SOUTH:
+        direction = (to == CardinalDirection::WEST) ? Direction::RIGHT : Direction::LEFT;
+        return to == CardinalDirection::EAST || to == CardinalDirection::WEST;
+    case CardinalDirection::EAST:
+        direction = (to == CardinalDirection::SOUTH) ? Direction::RIGHT : Direction::LEFT;
+        return to == CardinalDirection::NORTH || to == CardinalDirection::SOUTH;
+    case CardinalDirection::WEST:
+        direction = (to == CardinalDirection::NORTH) ? Direction::RIGHT : Direction::LEFT;
+        return to == CardinalDirection::NORTH || to == CardinalDirection::SOUTH;
+    default:
+        return false;
     }
 }
+
+bool Robot::isCrossPosition(const LinePosition &linePosition)
+{
+    return linePosition == LinePosition::CROSS_DETECTED || linePosition == LinePosition::CROSS_RIGHT_DETECTED ||
+           linePosition == LinePosition::CROSS_LEFT_DETECTED;
+}
+
+void Robot::setSegmentTimeout(uint16_t timeoutMs)
+{
+    segmentTimeoutMs_ = timeoutMs;
+}
+
+uint16_t Robot::getMeasuredSegmentTimeMs() const
+{
+    return measuredSegmentTimeMs_;
+}
+
 bool Robot::isRoadEnd() const
 {
     return isRoadEnd_;
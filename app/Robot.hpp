@@ -18,10 +18,14 @@
 #include "Led.hpp"
 #include "Navigation.hpp"
 #include "Button.hpp"
+#include "ButtonDebouncer.hpp"
+#include "EventQueue.hpp"
 #include "Sound.hpp"
 #include "res/enum/PathConfigState.hpp"
 #include "res/enum/RobotMode.hpp"
+#include "res/enum/InputEvent.hpp"
 #include "res/struct/RoadSchema.hpp"
+#include "res/struct/RoadPlan.hpp"
 #include "res/struct/Corner.hpp"
 #include "res/struct/TabSchema.hpp"
 #include "avr/interrupt.h"
@@ -32,6 +36,10 @@
 #include "customprocs.h"
 #include "SearchEngine.hpp"
 #include "ObstacleDetector.hpp"
+#include "PidController.hpp"
+#include "ControlLoop.hpp"
+#include "Scheduler.hpp"
+#include "PowerManager.hpp"
 #include "res/consts.hpp"
 
 #ifndef ROBOT_H
@@ -62,12 +70,42 @@ public:
     /**
      * @brief Met le robot en pause pour une période spécifiée.
      *
-     * Cette fonction utilise un délai pour suspendre l'exécution du programme,
-     * ce qui empêche toute action ou commande supplémentaire jusqu'à ce que le délai soit écoulé.
+     * Les tâches de fond (son, affichage, clignotement) continuent pendant l'attente.
      *
-     * @param delayMs Durée de l'attente en millisecondes.
+     * @param duration Durée de l'attente, convertie en ticks de l'ordonnanceur par l'appelant.
      */
-    void wait(uint16_t delayMs);
+    void wait(const ControlTicks &duration);
+
+    /**
+     * @brief Reprend les tâches de fond dont la mise en veille est écoulée.
+     *
+     * À appeler dans les boucles d'attente qui ne passent ni par wait ni par le suivi de ligne.
+     */
+    void runTasks();
+
+    /**
+     * @brief Attend la fin de toutes les tâches de fond.
+     */
+    void finishTasks();
+
+    /**
+     * @brief Met le robot en veille jusqu'au prochain événement de bouton ou débordement du timer 0.
+     *
+     * Sans événement en attente, le processeur est mis en veille profonde (POWER_DOWN) si le robot
+     * est immobile, sans tâche de fond ni bouton appuyé, et réveillé par un changement sur l'une des
+     * broches des boutons. Sinon, il est mis en veille légère (IDLE).
+     */
+    void sleepUntilInput();
+
+    /**
+     * @brief Coupe les périphériques inutiles pendant la saisie (ADC, et timer 2 une fois les sons terminés).
+     */
+    void suspendUnusedPeripherals();
+
+    /**
+     * @brief Rétablit les périphériques coupés par suspendUnusedPeripherals.
+     */
+    void resumePeripherals();
 
     /**
      * @brief Définit la couleur de la LED du robot et l'allume.
@@ -83,12 +121,13 @@ public:
      * @brief Fait clignoter la LED du robot pendant une durée déterminée.
      *
      * Cette fonction active la LED dans la couleur spécifiée, la fait clignoter
-     * pendant la période indiquée, puis l'éteint.
+     * pendant la période indiquée, puis l'éteint. Le clignotement est une tâche de fond: la
+     * fonction retourne immédiatement.
      *
      * @param color La couleur de la LED pendant le clignotement.
-     * @param duration La durée totale du clignotement en millisecondes.
+     * @param duration La durée totale du clignotement.
      */
-    void blinkLed(const LedColor &color, uint32_t duration);
+    void blinkLed(const LedColor &color, const Milliseconds &duration);
 
     /**
      * @brief Éteint la LED du robot.
@@ -97,8 +136,6 @@ public:
      */
     void turnOffLed();
 
-    void blinkLed(const LedColor &ledColor, double frequency);
-
     /**
      * @brief Joue une note de musique en utilisant le système sonore du robot.
      *
@@ -111,6 +148,8 @@ public:
 
     /**
      * @brief Joue le song du film pirates des caraibes
+     *
+     * La chanson est jouée par une tâche de fond: la fonction retourne immédiatement.
      */
     void playPiratesDesCaraibesSong();
 
@@ -132,12 +171,14 @@ public:
      * @param speedLeft La vitesse à laquelle le roue gauche doit se déplacer.
      * @param speedRight La vitesse à laquelle le roue gauche doit se déplacer.
      */
-    void moveTo(const Direction &direction, const double speedLeft, const double speedRight);
+    void moveTo(const Direction &direction, const DutyCycle &speedLeft, const DutyCycle &speedRight);
 
     /**
      * @brief Effectue un virage de 90 degrés.
      * @param direction Direction du virage (gauche ou droite).
      *        Permet de spécifier la direction du virage à effectuer.
+     *
+     * Le robot tourne sur place jusqu'à ce que la première ligne atteigne le capteur central.
      */
     void turn90Degre(const Direction &direction);
 
@@ -145,30 +186,46 @@ public:
      * @brief Effectue un demi-tour de 180 degrés.
      * @param direction Direction initiale du demi-tour (gauche ou droite).
      *        Indique la direction initiale du virage pour le demi-tour.
+     * @param nLinesToCross Nombre de lignes rencontrées pendant le demi-tour, ligne visée comprise
+     *        (2 si une route part du côté du virage, sinon 1).
      */
-    void turn180Degre(const Direction &direction);
+    void turn180Degre(const Direction &direction, uint8_t nLinesToCross);
 
     /**
-     * @brief Effectue un tour complet de 360 degrés.
-     * Le robot effectue un tour complet sur lui-même.
+     * @brief Effectue un virage de 90 degrés en arc, sans s'arrêter.
+     * @param direction Direction du virage (gauche ou droite).
+     *
+     * Le virage se termine dès que le capteur retrouve la ligne. Si la ligne n'est pas retrouvée
+     * après ARC_TURN_TIMEOUT_MS, le robot la cherche en tournant sur place. Le capteur est lu à
+     * chaque période de commande et les tâches de fond continuent pendant le virage.
      */
-    void turn360Degre();
+    void arcTurn90Degre(const Direction &direction);
 
     /**
      * @brief Suit une ligne tracée sur le sol.
      *
      * Le robot utilise ses capteurs pour suivre une ligne tracée sur le sol,
-     * en ajustant continuellement sa direction pour rester sur la ligne.
+     * en ajustant continuellement sa direction pour rester sur la ligne. Un régulateur PID calcule
+     * l'écart de vitesse entre les roues à partir de la position estimée de la ligne.
+     *
+     * Chaque appel attend d'abord le début de la prochaine période de la boucle de commande
+     * (CONTROL_LOOP_FREQUENCY_HZ): lecture, calcul et commande se font donc à fréquence fixe.
      */
     void followLine();
 
     /**
-     * @brief Recherche une ligne dans une direction spécifiée.
-     * @param direction La direction dans laquelle rechercher la ligne.
+     * @brief Tourne sur place jusqu'à atteindre une ligne donnée.
+     * @param direction La direction de la rotation.
+     * @param nLinesToCross Le rang de la ligne visée parmi les lignes rencontrées.
+     * @param timeout Durée maximale de la rotation.
      *
-     * Le robot tourne dans la direction spécifiée jusqu'à ce qu'il détecte une ligne.
+     * Le capteur central compte les lignes qu'il rencontre; la ligne de départ n'est pas comptée.
+     * Une ligne n'est comptée qu'après que la précédente a quitté tous les capteurs.
+     * Le robot s'arrête dès que la ligne visée atteint le capteur central, quelle que soit la
+     * vitesse réelle des roues, ou à l'expiration du délai, compté en périodes de commande. Les
+     * tâches de fond continuent pendant la rotation.
      */
-    void findLine(const Direction &direction);
+    void spinToLine(const Direction &direction, uint8_t nLinesToCross, const ControlPeriods &timeout);
 
     /**
      * @brief Arrête toute activité du robot.
@@ -187,10 +244,32 @@ public:
     void stopEngine();
 
     /**
-     * @brief Obtient l'objet chrono associé au robot.
-     * @return Référence à l'objet Chrono du robot.
+     * @brief Obtient l'horloge monotone du robot (timer 1).
+     * @return Référence vers l'objet MonotonicClock du robot.
+     */
+    MonotonicClock &getClock();
+
+    /**
+     * @brief Avance la roue des minuteries d'un tick (appelée par l'interruption TIMER1_COMPA_vect).
      */
-    Chrono &getChrono();
+    void tickTimers();
+
+    /**
+     * @brief Obtient le cadenceur de la boucle de commande.
+     * @return Référence vers l'objet ControlLoop du robot.
+     */
+    ControlLoop &getControlLoop();
+
+    /**
+     * @brief Avance les rampes de vitesse des roues d'une période de commande (appelée par
+     * l'interruption TIMER0_OVF_vect).
+     */
+    void updateMotion();
+
+    /**
+     * @brief Capture une transition des capteurs de ligne (appelée par l'interruption PCINT0_vect).
+     */
+    void captureLineTransition();
 
     /**
      * @brief Obtient l'objet CornerNode actuel du robot.
@@ -258,25 +337,25 @@ public:
     // Méthodes de gestion des boutons sur la carte mère
 
     /**
-     * @brief Vérifie si le bouton poussoir de la carte mere est pressé.
-     *
-     * @return true si le bouton est pressé, false sinon.
+     * @brief Obtient la file des événements des boutons (appuis, appuis longs, répétitions).
+     * @return Référence vers la file, remplie par l'interruption TIMER0_OVF_vect.
      */
-    bool isButtonMotherBoardPressed();
+    EventQueue &getInputEvents();
 
     /**
-     * @brief Vérifie si le bouton de validation sur le breadBoard est pressé.
+     * @brief Abandonne les événements de bouton en attente, une fois tous les boutons relâchés.
      *
-     * @return true si le bouton est pressé, false sinon.
+     * Les appuis faits pendant un trajet, et les appuis longs ou répétitions d'un bouton encore
+     * maintenu, ne doivent pas être rejoués dans la saisie suivante. Les tâches de fond continuent
+     * pendant l'attente du relâchement.
      */
-    bool isButtonValidationPressed();
+    void discardInputEvents();
 
     /**
-     * @brief Vérifie si le bouton de selection sur le breadboard est pressé.
-     *
-     * @return true si le bouton est pressé, false sinon.
+     * @brief Échantillonne les boutons pour l'anti-rebond (appelée par l'interruption TIMER0_OVF_vect
+     * à chaque période de commande).
      */
-    bool isButtonSelectionPressed();
+    void sampleButtons();
 
     /**
      * @brief Définit le mode de fonctionnement du robot.
@@ -325,6 +404,12 @@ public:
      */
     void resetFinalPoint();
 
+    /**
+     * @brief Définit le point final de navigation du robot.
+     * @param finalPoint Les coordonnées de la prochaine destination.
+     */
+    void setFinalPoint(const Coordinate &finalPoint);
+
     /**
      * @brief Obtient le point initial de départ du robot.
      * @return Une référence constante aux coordonnées du point initial.
@@ -352,8 +437,18 @@ public:
      */
     const Coordinate &getCurrentPoint() const;
 
+    /**
+     * @brief Obtient l'orientation du robot au point de départ du prochain trajet.
+     * @return La direction cardinale dans laquelle le robot est orienté.
+     */
+    const CardinalDirection &getInitialDirection() const;
+
     /**
      * @brief Définit le schéma de route pour le robot.
+     *
+     * Le schéma est compilé en lignes droites (RoadPlan): les segments consécutifs de même direction
+     * forment une seule primitive.
+     *
      * @param roadSchema Le schéma de route à suivre.
      */
     void setRoad(const RoadSchema &roadSchema);
@@ -379,7 +474,9 @@ public:
     /**
      * @brief Suit le chemin défini dans le schéma de route.
      *
-     * Le robot suit le chemin défini, en prenant des décisions à chaque intersection.
+     * Chaque appel parcourt un segment. Les intersections intermédiaires d'une ligne droite sont
+     * comptées sans arrêt. À la dernière, un virage de 90 degrés est pris en arc en roulant; le
+     * robot ne s'arrête que pour un demi-tour ou à l'arrivée.
      */
     void followRoad();
 
@@ -389,6 +486,28 @@ public:
      */
     Coordinate getNextPoint() const;
 
+    /**
+     * @brief Obtient le point atteint à la fin de la prochaine étape de la route.
+     *
+     * Identique au point courant si la prochaine étape n'est pas un segment (départ ou arrivée).
+     *
+     * @return Le point de coordonnée après la prochaine étape.
+     */
+    Coordinate getUpcomingPoint() const;
+
+    /**
+     * @brief Définit le délai accordé au prochain segment avant de chercher l'intersection.
+     * @param timeoutMs Le délai en millisecondes.
+     */
+    void setSegmentTimeout(uint16_t timeoutMs);
+
+    /**
+     * @brief Obtient le temps mesuré pour le segment parcouru lors du dernier appel à followRoad.
+     * @return Le temps en millisecondes, ou 0 si aucun segment n'a été chronométré ou si le délai a
+     *         expiré avant l'intersection (la mesure ne serait que le délai lui-même).
+     */
+    uint16_t getMeasuredSegmentTimeMs() const;
+
     /**
      * @brief Met à jour le point de coordonnée actuel du robot.
      */
@@ -401,6 +520,14 @@ public:
      */
     void endRoadRoutine();
 
+    /**
+     * @brief Abandonne le trajet lorsque la destination est inaccessible.
+     *
+     * Le robot s'arrête et affiche le message sur l'écran. Contrairement à endRoadRoutine, il ne
+     * se considère pas arrivé: le prochain trajet part du point où il s'est arrêté.
+     */
+    void reportUnreachableDestination();
+
     /**
      * @brief Vérifie si le robot est à la fin du trajet.
      * @return true si le robot est à la fin du trajet, false sinon.
@@ -430,33 +557,140 @@ private:
     Led led_;                           // objet Led pour la gestion des LED.
     Sound sound_;                       // objet Sound pour la gestion des sons.
     Navigation nav_;                    // Objet pour la gestion de la navigation du robot.
-    Chrono chrono_;                     // Gère le chronométrage pour diverses tâches temporisées du robot.
+    MonotonicClock clock_;              // Horloge monotone à la microseconde (timer 1).
+    TimerWheel timerWheel_;             // Minuteries logicielles cadencées par l'horloge.
+    Chrono chrono_;                     // Délai du segment ou de l'avance avant une décision.
     SearchEngine searchEngine_;         // Moteur de recherche utilisé pour la recherche de coin.
     LCM lcm_;                           // Interface pour communiquer avec un écran LCD.
     Button buttonMotherBoard_;          // Bouton sur la carte mère pour les interactions utilisateur.
     Button buttonValidation_;           // Bouton pour valider les sélections ou les commandes.
     Button buttonSelection_;            // Bouton pour naviguer dans les menus ou les options.
+    EventQueue inputEvents_;            // Événements des boutons, traités par la boucle principale.
+    ButtonDebouncer buttonDebouncer_;   // Anti-rebond périodique des trois boutons.
+    PowerManager power_;                // Veille du processeur et coupure des périphériques.
+    uint16_t lastWakeTick_;             // Tick du dernier réveil de veille profonde.
+    ControlLoop controlLoop_;           // Cadence fixe de la boucle de suivi de ligne.
+    Scheduler scheduler_;               // Tâches de fond (son, affichage, clignotement).
     LineSensor lineSensor_;             // Capteur de ligne pour la détection et le suivi de lignes au sol.
     ObstacleDetector obstacleDetector_; // Détecteur d'obstacles pour éviter les collisions.
+    PidController linePid_;             // Régulateur du suivi de ligne (position de la ligne -> écart de vitesse des roues).
     LinePosition linePosition_;         // Position actuelle par rapport à la ligne détectée.
     CornerNode initialCorner_;          // coin Initial détecté pour l'identification des coins.
-    bool isChronoRunning_;              // Indique si le chronomètre est actif.
+    volatile bool isChronoRunning_;     // Indique si le chronomètre est actif.
+    volatile bool isChronoStepPending_; // Une étape 'A' (chrono expiré) attend d'être ajoutée au schéma.
     bool isFirstChronoRunning_;         // Indique si le premier chronomètre (pour un usage spécifique) est actif.
     TabSchema currentSchema_;           // Schéma actuel construit par le robot pour la navigation lors de son parcours.
     bool isInitialCornerFound_;         // Indique si le premier coin a été trouvé.
     bool isReturnToIntialaCorner_;      // Indique si le robot est revenu au premier coin.
     bool isObstacleDetected_;           // Indique si un obstacle a été détecté.
-    bool isGoForwardBeforeTakeDecision_;
+    volatile bool isGoForwardBeforeTakeDecision_; // Le robot avance jusqu'à l'échéance du chrono avant de décider.
     RobotMode mode_;                     // Mode actuel de fonctionnement du robot.
     Coordinate initialPoint_;            // Point initial de départ du robot.
     Coordinate currentPoint_;            // Point de coordonnée actuel du robot.
     Coordinate finalPoint_;              // Point final de destination du robot.
-    RoadSchema roadSchema_;              // Schéma de la route ou du trajet à suivre.
+    RoadPlan roadPlan_;                  // Trajet à suivre, sous forme de lignes droites.
     CardinalDirection initialDirection_; // Direction initiale du robot.
-    uint8_t currentIndexRoad_;           // Index actuel dans le schéma de route.
+    uint8_t currentPrimitive_;           // Index de la ligne droite en cours dans le trajet.
+    uint8_t nIntersectionsPassed_;       // Intersections déjà atteintes sur la ligne droite en cours.
+    bool isRoadStarted_;                 // Indique si le virage de départ a été fait.
+    bool isAtNode_;                      // Le robot est sur le point courant, et non entre deux points après un obstacle.
     CardinalDirection currentDirection_; // Direction courante, commence par START.
     CardinalDirection nextDirection_;    // Direction suivante à prendre par le robot.
     bool isRoadEnd_;                     // Indique si le robot est arrivé à la fin de la route prévue.
+    uint16_t segmentTimeoutMs_;          // Délai accordé au segment en cours.
+    uint16_t measuredSegmentTimeMs_;     // Temps mesuré du dernier segment parcouru (0 si aucun).
+    LedColor blinkColor_;                // Couleur du clignotement en cours.
+    uint8_t nBlinks_;                    // Nombre de clignotements de la tâche de clignotement.
+    uint8_t identifyBlinkTimer_;         // Minuterie du clignotement pendant la recherche du coin.
+    bool isIdentifyLedOn_;               // La LED du clignotement de recherche est allumée.
+
+    /**
+     * @brief Échéance du chrono (interruption de la roue): fin du segment ou de l'avance avant décision.
+     * @param context Le robot.
+     */
+    static void onChronoExpired(void *context);
+
+    /**
+     * @brief Clignotement de la LED verte pendant la recherche du coin (interruption de la roue).
+     * @param context Le robot.
+     */
+    static void onIdentifyBlink(void *context);
+
+    /**
+     * @brief Tâche de fond: clignotement de la LED (nBlinks_ fois, en blinkColor_).
+     * @param task La tâche, dont le contexte est le robot.
+     * @return bool Vrai tant que la tâche n'est pas terminée.
+     */
+    static bool blinkTask(Task &task);
+
+    /**
+     * @brief Tâche de fond: chanson pirates des caraibes.
+     * @param task La tâche, dont le contexte est le robot.
+     * @return bool Vrai tant que la tâche n'est pas terminée.
+     */
+    static bool piratesSongTask(Task &task);
+
+    /**
+     * @brief Tâche de fond: mélodie de fin de trajet.
+     * @param task La tâche, dont le contexte est le robot.
+     * @return bool Vrai tant que la tâche n'est pas terminée.
+     */
+    static bool endRoadSongTask(Task &task);
+
+    /**
+     * @brief Tâche de fond: son et messages affichés après la détection d'un obstacle.
+     * @param task La tâche, dont le contexte est le robot.
+     * @return bool Vrai tant que la tâche n'est pas terminée.
+     */
+    static bool obstacleNoticeTask(Task &task);
+
+    /**
+     * @brief Calcule le point voisin dans une direction donnée.
+     * @param point Le point de départ.
+     * @param direction La direction du déplacement (START et END ne déplacent pas le point).
+     * @return Le point voisin.
+     */
+    static Coordinate movePoint(const Coordinate &point, const CardinalDirection &direction);
+
+    /**
+     * @brief Indique si une position de ligne correspond à une intersection.
+     * @param linePosition La position lue par le capteur de ligne.
+     * @return true si une croix (complète, à gauche ou à droite) est détectée.
+     */
+    static bool isCrossPosition(const LinePosition &linePosition);
+
+    /**
+     * @brief Traverse une intersection d'une ligne droite sans s'arrêter.
+     *
+     * La traversée dure au plus CROSS_PASS_TIMEOUT_MS. Un obstacle vu pendant la traversée est
+     * traité comme sur un segment: le robot recule et le trajet est replanifié.
+     */
+    void passIntersection();
+
+    /**
+     * @brief Recule pour s'éloigner d'un obstacle détecté devant le robot.
+     */
+    void backAwayFromObstacle();
+
+    /**
+     * @brief S'arrête au centre de l'intersection et tourne vers la direction suivante.
+     */
+    void stopAtIntersection();
+
+    /**
+     * @brief Tourne de 90 degrés à une intersection en continuant de rouler.
+     * @param direction Direction du virage (gauche ou droite).
+     */
+    void turnAtIntersection(const Direction &direction);
+
+    /**
+     * @brief Détermine si un changement de direction est un virage de 90 degrés.
+     * @param from La direction courante.
+     * @param to La direction suivante.
+     * @param direction Reçoit le sens du virage (gauche ou droite).
+     * @return true s'il s'agit d'un virage de 90 degrés.
+     */
+    static bool getQuarterTurn(const CardinalDirection &from, const CardinalDirection &to, Direction &direction);
 };
 
 #endif
\ No newline at end of file
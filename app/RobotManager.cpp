@@ -7,101 +7,170 @@
  */
 
 #include "RobotManager.hpp"
+#include <avr/pgmspace.h>
 
-RobotManager::RobotManager() : isSelected(false), isValidated(false), isYes(true)
-{
-}
+// Table de la machine a etats de selection: les transitions des etats composites s'appliquent a
+// leurs sous-etats (voir getParentState). Maintenir le bouton de selection fait defiler la ligne ou
+// la colonne (appui long puis repetitions).
+const SelectionTransition RobotManager::selectionTransitions[] PROGMEM = {
+    {PathConfigState::ROW_ENTRY, InputEvent::SELECTION_PRESSED, nullptr, PathConfigState::SELECT_ROW, &RobotManager::incrementRow},
+    {PathConfigState::ROW_ENTRY, InputEvent::SELECTION_LONG_PRESSED, nullptr, PathConfigState::SELECT_ROW, &RobotManager::incrementRow},
+    {PathConfigState::ROW_ENTRY, InputEvent::SELECTION_REPEATED, nullptr, PathConfigState::SELECT_ROW, &RobotManager::incrementRow},
+    {PathConfigState::ROW_ENTRY, InputEvent::VALIDATION_PRESSED, nullptr, PathConfigState::INIT_COL, &RobotManager::displayState},
+    {PathConfigState::COLUMN_ENTRY, InputEvent::SELECTION_PRESSED, nullptr, PathConfigState::SELECT_COLUMN, &RobotManager::incrementColumn},
+    {PathConfigState::COLUMN_ENTRY, InputEvent::SELECTION_LONG_PRESSED, nullptr, PathConfigState::SELECT_COLUMN, &RobotManager::incrementColumn},
+    {PathConfigState::COLUMN_ENTRY, InputEvent::SELECTION_REPEATED, nullptr, PathConfigState::SELECT_COLUMN, &RobotManager::incrementColumn},
+    {PathConfigState::COLUMN_ENTRY, InputEvent::VALIDATION_PRESSED, nullptr, PathConfigState::INIT_CONFIRMATION, &RobotManager::displayState},
+    {PathConfigState::CONFIRMATION_ENTRY, InputEvent::SELECTION_PRESSED, nullptr, PathConfigState::CONFIRMATION, &RobotManager::toggleConfirmation},
+    {PathConfigState::CONFIRMATION_ENTRY, InputEvent::VALIDATION_PRESSED, &RobotManager::isConfirmed, PathConfigState::FINALIZED, nullptr},
+    {PathConfigState::CONFIRMATION_ENTRY, InputEvent::VALIDATION_PRESSED, nullptr, PathConfigState::RESET, &RobotManager::resetDestination},
+    {PathConfigState::RESET, InputEvent::SELECTION_PRESSED, nullptr, PathConfigState::SELECT_ROW, &RobotManager::incrementRow},
+    {PathConfigState::RESET, InputEvent::VALIDATION_PRESSED, nullptr, PathConfigState::SELECT_ROW, &RobotManager::incrementRow},
+};
 
-void RobotManager::updateSelectionJourneyRoutine(volatile PathConfigState &pathConfigState)
+// Etat composite parent d'un etat de la selection (la racine est son propre parent)
+static PathConfigState getParentState(PathConfigState state)
 {
-    switch (pathConfigState)
+    switch (state)
     {
     case PathConfigState::INIT_ROW:
     case PathConfigState::SELECT_ROW:
-        if (isSelected)
-            pathConfigState = PathConfigState::SELECT_ROW;
-        else if (isValidated)
-            pathConfigState = PathConfigState::INIT_COL;
-        break;
+        return PathConfigState::ROW_ENTRY;
     case PathConfigState::INIT_COL:
     case PathConfigState::SELECT_COLUMN:
-        if (isSelected)
-            pathConfigState = PathConfigState::SELECT_COLUMN;
-        else if (isValidated)
-            pathConfigState = PathConfigState::INIT_CONFIRMATION;
-        break;
+        return PathConfigState::COLUMN_ENTRY;
     case PathConfigState::INIT_CONFIRMATION:
     case PathConfigState::CONFIRMATION:
-        if (isSelected)
-            pathConfigState = PathConfigState::CONFIRMATION;
-        else if (isValidated)
-        {
-            if (isYes)
-                pathConfigState = PathConfigState::FINALIZED;
-            else
-                pathConfigState = PathConfigState::RESET;
-        }
-        break;
-    case PathConfigState::RESET:
-        pathConfigState = PathConfigState::SELECT_ROW;
-        break;
-    case PathConfigState::FINALIZED:
-        break;
+        return PathConfigState::CONFIRMATION_ENTRY;
+    default:
+        return PathConfigState::DESTINATION_ENTRY;
     }
 }
 
-void RobotManager::executeSelectionRoutineMode(const volatile PathConfigState &pathConfigState, Robot *robot)
+// Un chemin vide ne mene a la destination que si le robot y est deja
+static bool isRoadMissing(const RoadSchema &road, const Coordinate &from, const Coordinate &to)
+{
+    return road.size == 0 && (from.row != to.row || from.column != to.column);
+}
+
+RobotManager::RobotManager(EventQueue *inputEvents) : isYes(true), inputEvents(inputEvents)
+{
+}
+
+void RobotManager::processInputEvents(Robot *robot, volatile PathConfigState &pathConfigState)
 {
-    switch (pathConfigState)
+    uint8_t code;
+    while (inputEvents->pop(code))
     {
-    case PathConfigState::INIT_ROW:
-        robot->displayJourneyMode(pathConfigState);
-        break;
-    case PathConfigState::SELECT_ROW:
-        robot->incrementPointRow();
-        robot->displayJourneyMode(pathConfigState);
-        break;
-    case PathConfigState::INIT_COL:
-        robot->displayJourneyMode(pathConfigState);
-        break;
-    case PathConfigState::SELECT_COLUMN:
-        robot->incrementPointCol();
-        robot->displayJourneyMode(pathConfigState);
-        break;
-    case PathConfigState::INIT_CONFIRMATION:
-        robot->displayJourneyMode(pathConfigState);
-        break;
-    case PathConfigState::RESET:
-        if (isValidated)
+        InputEvent event = static_cast<InputEvent>(code);
+        if (robot->getMode() == RobotMode::UNDEFINED)
         {
-            if (!isYes)
-            {
-                robot->resetFinalPoint();
-                robot->displayJourneyMode(pathConfigState);
-                isYes = true;
-            }
+            selectMode(event, robot);
+            // les evenements suivants appartiennent a l'appui qui a choisi le mode
+            if (robot->getMode() != RobotMode::UNDEFINED)
+                return;
         }
-        break;
-    case PathConfigState::CONFIRMATION:
-        if (isSelected)
+        else if (robot->getMode() == RobotMode::MAKE_JOURNEY || robot->getMode() == RobotMode::MAKE_TOUR)
+            dispatchSelectionEvent(event, pathConfigState, robot);
+    }
+}
+
+void RobotManager::selectMode(InputEvent pressed, Robot *robot)
+{
+    if (pressed == InputEvent::MOTHER_BOARD_PRESSED)
+        robot->setMode(RobotMode::IDENTIFY_CORNER);
+    else if (pressed == InputEvent::SELECTION_PRESSED)
+        robot->setMode(RobotMode::MAKE_JOURNEY);
+    else if (pressed == InputEvent::VALIDATION_PRESSED)
+        robot->setMode(RobotMode::MAKE_TOUR); // toutes les destinations saisies avant le depart
+}
+
+bool RobotManager::dispatchSelectionEvent(InputEvent event, volatile PathConfigState &pathConfigState, Robot *robot)
+{
+    const uint8_t nTransitions = sizeof(selectionTransitions) / sizeof(selectionTransitions[0]);
+    PathConfigState state = pathConfigState;
+    while (true)
+    {
+        for (uint8_t i = 0; i < nTransitions; i++)
         {
-            isYes = !isYes;
-            robot->displayJourneyMode(pathConfigState, isYes);
+            SelectionTransition transition;
+            memcpy_P(&transition, &selectionTransitions[i], sizeof(transition));
+            if (transition.state != state || transition.event != event)
+                continue;
+            if (transition.guard != nullptr && !transition.guard(*this))
+                continue;
+            pathConfigState = transition.nextState;
+            if (transition.action != nullptr)
+                transition.action(*this, robot, pathConfigState);
+            return true;
         }
-        break;
-    case PathConfigState::FINALIZED:
-        break;
+        // aucune transition: l'evenement remonte a l'etat parent
+        PathConfigState parent = getParentState(state);
+        if (parent == state)
+            return false;
+        state = parent;
     }
 }
 
-void RobotManager::setIsSelected(bool value)
+void RobotManager::waitForMode(Robot *robot, volatile PathConfigState &pathConfigState)
 {
-    isSelected = value;
+    while (robot->getMode() == RobotMode::UNDEFINED)
+    {
+        robot->suspendUnusedPeripherals();
+        processInputEvents(robot, pathConfigState);
+        robot->sleepUntilInput();
+    }
+    robot->resumePeripherals();
+    robot->discardInputEvents();
+}
+
+void RobotManager::waitForDestination(Robot *robot, volatile PathConfigState &pathConfigState)
+{
+    robot->displayJourneyMode(pathConfigState);
+    while (pathConfigState != PathConfigState::FINALIZED)
+    {
+        processInputEvents(robot, pathConfigState);
+        robot->runTasks();
+        // le timer 2 n'est coupe qu'une fois les sons de fin de trajet termines
+        robot->suspendUnusedPeripherals();
+        robot->sleepUntilInput();
+    }
+    robot->resumePeripherals();
 }
 
-void RobotManager::setIsValidated(bool value)
+bool RobotManager::isConfirmed(const RobotManager &manager)
 {
-    isValidated = value;
+    return manager.isYes;
+}
+
+void RobotManager::displayState(RobotManager &manager, Robot *robot, const volatile PathConfigState &pathConfigState)
+{
+    robot->displayJourneyMode(pathConfigState);
+}
+
+void RobotManager::incrementRow(RobotManager &manager, Robot *robot, const volatile PathConfigState &pathConfigState)
+{
+    robot->incrementPointRow();
+    robot->displayJourneyMode(pathConfigState);
+}
+
+void RobotManager::incrementColumn(RobotManager &manager, Robot *robot, const volatile PathConfigState &pathConfigState)
+{
+    robot->incrementPointCol();
+    robot->displayJourneyMode(pathConfigState);
+}
+
+void RobotManager::toggleConfirmation(RobotManager &manager, Robot *robot, const volatile PathConfigState &pathConfigState)
+{
+    manager.isYes = !manager.isYes;
+    robot->displayJourneyMode(pathConfigState, manager.isYes);
+}
+
+void RobotManager::resetDestination(RobotManager &manager, Robot *robot, const volatile PathConfigState &pathConfigState)
+{
+    robot->resetFinalPoint();
+    robot->displayJourneyMode(pathConfigState);
+    manager.isYes = true;
 }
 
 void RobotManager::setIsYes(bool value)
@@ -119,6 +188,9 @@ void RobotManager::runRobotRoutine(Robot *robot, volatile PathConfigState &pathC
     case RobotMode::MAKE_JOURNEY:
         executeMakeJourneyRoutine(robot, pathConfigState);
         break;
+    case RobotMode::MAKE_TOUR:
+        executeMakeTourRoutine(robot, pathConfigState);
+        break;
     default:
         break;
     }
@@ -127,7 +199,7 @@ void RobotManager::runRobotRoutine(Robot *robot, volatile PathConfigState &pathC
 void RobotManager::executeIdentifyCornerRoutine(Robot *robot)
 {
     robot->turnOffLed();
-    _delay_ms(DELAY_BEFORE_START_IDENTIFY_CORNER_MS);
+    robot->wait(DELAY_BEFORE_START_IDENTIFY_CORNER_MS);
     while (!robot->isReturnToInitialCorner())
     {
         robot->searchInitialCornerAndReturn();
@@ -137,39 +209,106 @@ void RobotManager::executeIdentifyCornerRoutine(Robot *robot)
 void RobotManager::executeMakeJourneyRoutine(Robot *robot, volatile PathConfigState &pathConfigState)
 {
     robot->turnOffLed();
-    Dijkstra dijkstra;
+    Dijkstra dijkstra(JOURNEY_PLANNER_MODE);
     for (uint8_t i = 0; i < N_ROAD; i++)
     {
-        robot->displayJourneyMode(pathConfigState);
-        while (pathConfigState != PathConfigState::FINALIZED)
-            ;
-        RoadSchema roadShema = dijkstra.generateRoad(robot->getInitialPoint(), robot->getFinalPoint());
-        robot->setRoad(roadShema);
-        while (!robot->isRoadEnd())
+        waitForDestination(robot, pathConfigState);
+        obstacleMap.startRun();
+        obstacleMap.applyTo(dijkstra, robot->getInitialPoint(), &robot->getFinalPoint(), 1);
+        driveToFinalPoint(robot, dijkstra);
+        resetMakeJourneyRoutine(pathConfigState, robot, dijkstra);
+    }
+}
+
+void RobotManager::executeMakeTourRoutine(Robot *robot, volatile PathConfigState &pathConfigState)
+{
+    robot->turnOffLed();
+    Dijkstra dijkstra(JOURNEY_PLANNER_MODE);
+
+    // saisie de toutes les destinations avant le depart
+    Coordinate destinations[MAX_TOUR_SIZE];
+    for (uint8_t i = 0; i < MAX_TOUR_SIZE; i++)
+    {
+        waitForDestination(robot, pathConfigState);
+        destinations[i] = robot->getFinalPoint();
+        robot->resetFinalPoint();
+        resetSelectionRoutine(pathConfigState);
+    }
+
+    // les obstacles connus sont evites des la planification de la tournee
+    obstacleMap.startRun();
+    obstacleMap.applyTo(dijkstra, robot->getInitialPoint(), destinations, MAX_TOUR_SIZE);
+
+    uint8_t order[MAX_TOUR_SIZE];
+    TourPlanner tourPlanner;
+    tourPlanner.planTour(dijkstra, robot->getInitialPoint(), robot->getInitialDirection(), destinations, MAX_TOUR_SIZE, order);
+
+    // la tournee s'enchaine sans repasser par l'ecran de selection; une destination inaccessible,
+    // placee en fin de tournee, est signalee sur l'ecran par driveToFinalPoint
+    for (uint8_t i = 0; i < MAX_TOUR_SIZE; i++)
+    {
+        const Coordinate &destination = destinations[order[i]];
+        if (destination.row == robot->getInitialPoint().row && destination.column == robot->getInitialPoint().column)
+            continue; // deja sur place
+        robot->setFinalPoint(destination);
+        driveToFinalPoint(robot, dijkstra);
+        robot->setIsRoadEnd(false);
+    }
+
+    // oublie les segments bloques (ils restent dans la carte des obstacles)
+    dijkstra.resetObstacles();
+    robot->discardInputEvents();
+}
+
+void RobotManager::driveToFinalPoint(Robot *robot, Dijkstra &dijkstra)
+{
+    RoadSchema roadShema = dijkstra.generateRoad(robot->getInitialPoint(), robot->getFinalPoint(), robot->getInitialDirection());
+    if (isRoadMissing(roadShema, robot->getInitialPoint(), robot->getFinalPoint()))
+    {
+        robot->reportUnreachableDestination();
+        return;
+    }
+    robot->setRoad(roadShema);
+    while (!robot->isRoadEnd())
+    {
+        // delai du segment a partir de son temps appris
+        Coordinate from = robot->getCurrentPoint();
+        Coordinate to = robot->getUpcomingPoint();
+        robot->setSegmentTimeout(dijkstra.getSegmentTimeout(from, to));
+        robot->followRoad();
+        if (robot->getMeasuredSegmentTimeMs() != 0)
+            dijkstra.learnSegmentTime(from, to, robot->getMeasuredSegmentTimeMs());
+        // verifier si obstacle detecté
+        if (robot->isObstacleDetected())
         {
-            robot->followRoad();
-            // verifier si obstacle detecté
-            if (robot->isObstacleDetected())
+            // detruit le point recalculer le nouveau parcours et faire une setRoad
+            dijkstra.destroyPath(robot->getNextPoint());
+            obstacleMap.recordObstacle(robot->getNextPoint());
+            roadShema = dijkstra.generateRoad(robot->getCurrentPoint(), robot->getFinalPoint(), robot->getInitialDirection());
+            if (isRoadMissing(roadShema, robot->getCurrentPoint(), robot->getFinalPoint()))
             {
-                // detruit le point recalculer le nouveau parcours et faire une setRoad
-                dijkstra.destroyPath(robot->getNextPoint());
-                roadShema = dijkstra.generateRoad(robot->getCurrentPoint(), robot->getFinalPoint());
-                robot->setRoad(roadShema);
+                // les obstacles isolent la destination: le robot ne doit pas se croire arrive
+                robot->reportUnreachableDestination();
+                return;
             }
+            robot->setRoad(roadShema);
         }
-
-        resetMakeJourneyRoutine(pathConfigState, robot, dijkstra);
     }
 }
 
 void RobotManager::resetMakeJourneyRoutine(volatile PathConfigState &pathConfigState, Robot *robot, Dijkstra &dijkstra)
 {
-    pathConfigState = PathConfigState::INIT_ROW;
-    setIsSelected(false);
-    setIsValidated(false);
-    setIsYes(true);
+    resetSelectionRoutine(pathConfigState);
     robot->setIsRoadEnd(false);
+    // les appuis faits pendant le trajet ne valent pas pour la destination suivante
+    robot->discardInputEvents();
 
-    // reset le matrice adjacence
-    dijkstra.initMatrix();
+    // oublie les segments bloques; ceux de la carte des obstacles sont rebloques au prochain parcours
+    dijkstra.resetObstacles();
+}
+
+void RobotManager::resetSelectionRoutine(volatile PathConfigState &pathConfigState)
+{
+    pathConfigState = PathConfigState::INIT_ROW;
+    setIsYes(true);
 }
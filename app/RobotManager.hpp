@@ -10,6 +10,10 @@
 #define ROBOT_MANAGER_H
 #include "Robot.hpp"
 #include "Dijkstra.hpp"
+#include "TourPlanner.hpp"
+#include "ObstacleMap.hpp"
+#include "EventQueue.hpp"
+#include "res/struct/SelectionTransition.hpp"
 #include "res/consts.hpp"
 
 /**
@@ -23,15 +27,39 @@
 class RobotManager
 {
 private:
-    bool isSelected;  // Indique si une option de navigation est sélectionnée.
-    bool isValidated; // Indique si une option de navigation est validée.
-    bool isYes;       // Utilisé pour confirmer les sélections ou les décisions.
+    bool isYes;                                            // Utilisé pour confirmer les sélections ou les décisions.
+    EventQueue *inputEvents;                               // Événements des boutons déposés par l'anti-rebond.
+    ObstacleMap obstacleMap;                               // Obstacles mémorisés d'un parcours à l'autre en mémoire externe.
+    static const SelectionTransition selectionTransitions[]; // Table de la machine à états de sélection (en mémoire flash).
+
+    /**
+     * @brief Choisit le mode du robot selon le bouton appuyé.
+     *
+     * Le bouton de la carte mère lance l'identification du coin, le bouton de sélection un trajet
+     * et le bouton de validation une tournée.
+     *
+     * @param pressed L'appui.
+     * @param robot Pointeur vers l'instance du robot.
+     */
+    void selectMode(InputEvent pressed, Robot *robot);
+
+    // Conditions et actions de la table de sélection
+    static bool isConfirmed(const RobotManager &manager);
+    static void displayState(RobotManager &manager, Robot *robot, const volatile PathConfigState &pathConfigState);
+    static void incrementRow(RobotManager &manager, Robot *robot, const volatile PathConfigState &pathConfigState);
+    static void incrementColumn(RobotManager &manager, Robot *robot, const volatile PathConfigState &pathConfigState);
+    static void toggleConfirmation(RobotManager &manager, Robot *robot, const volatile PathConfigState &pathConfigState);
+    static void resetDestination(RobotManager &manager, Robot *robot, const volatile PathConfigState &pathConfigState);
 
 public:
     /**
      * @brief Constructeur de RobotManager.
+     *
+     * Relit la carte des obstacles mémorisée lors des parcours précédents.
+     *
+     * @param inputEvents File où l'anti-rebond des boutons dépose leurs événements.
      */
-    RobotManager();
+    RobotManager(EventQueue *inputEvents);
 
     /**
      * @brief Destructeur par défaut de RobotManager.
@@ -39,29 +67,42 @@ public:
     ~RobotManager() = default;
 
     /**
-     * @brief Met à jour la routine de sélection de parcours.
-     * @param pathConfigState État actuel du parcours du robot.
+     * @brief Traite les événements des boutons en attente, dans la boucle principale.
+     *
+     * Tant que le mode du robot n'est pas choisi, un appui choisit le mode. Ensuite, les événements
+     * sont transmis à la machine à états de sélection du point de destination.
+     *
+     * @param robot Pointeur vers l'instance du robot.
+     * @param pathConfigState État actuel de la configuration du parcours.
      */
-    void updateSelectionJourneyRoutine(volatile PathConfigState &pathConfigState);
+    void processInputEvents(Robot *robot, volatile PathConfigState &pathConfigState);
 
     /**
-     * @brief Exécute la routine de sélection en fonction de l'état du parcours.
-     * @param pathConfigState État actuel du parcours.
+     * @brief Transmet un événement de bouton à la machine à états hiérarchique de sélection.
+     *
+     * La transition est cherchée dans l'état courant, puis dans ses états composites parents.
+     * Un événement sans transition est ignoré.
+     *
+     * @param event L'événement du bouton.
+     * @param pathConfigState État actuel de la configuration du parcours.
      * @param robot Pointeur vers l'instance du robot.
+     * @return true si une transition a été effectuée.
      */
-    void executeSelectionRoutineMode(const volatile PathConfigState &pathConfigState, Robot *robot);
+    bool dispatchSelectionEvent(InputEvent event, volatile PathConfigState &pathConfigState, Robot *robot);
 
     /**
-     * @brief Définit l'état de sélection.
-     * @param value Nouvel état de sélection.
+     * @brief Attend que le mode du robot soit choisi par un bouton.
+     * @param robot Pointeur vers l'instance du robot.
+     * @param pathConfigState État actuel de la configuration du parcours.
      */
-    void setIsSelected(bool value);
+    void waitForMode(Robot *robot, volatile PathConfigState &pathConfigState);
 
     /**
-     * @brief Définit l'état de validation.
-     * @param value Nouvel état de validation.
+     * @brief Attend que la saisie du point de destination soit terminée.
+     * @param robot Pointeur vers l'instance du robot.
+     * @param pathConfigState État actuel de la configuration du parcours.
      */
-    void setIsValidated(bool value);
+    void waitForDestination(Robot *robot, volatile PathConfigState &pathConfigState);
 
     /**
      * @brief Définit l'état de confirmation.
@@ -90,6 +131,24 @@ public:
      */
     void executeMakeJourneyRoutine(Robot *robot, volatile PathConfigState &pathConfigState);
 
+    /**
+     * @brief Exécute la routine de tournée.
+     *
+     * Toutes les destinations sont saisies avant le départ, puis le robot les visite dans l'ordre
+     * qui minimise le coût total, sans repasser par l'écran de sélection entre deux destinations.
+     *
+     * @param robot Pointeur vers l'instance du robot.
+     * @param pathConfigState État actuel de la configuration du parcours.
+     */
+    void executeMakeTourRoutine(Robot *robot, volatile PathConfigState &pathConfigState);
+
+    /**
+     * @brief Conduit le robot jusqu'à son point final en replanifiant à chaque obstacle.
+     * @param robot Pointeur vers l'instance du robot.
+     * @param dijkstra Instance de l'algorithme de Dijkstra utilisé pour le calcul de parcours.
+     */
+    void driveToFinalPoint(Robot *robot, Dijkstra &dijkstra);
+
     /**
      * @brief Réinitialise la routine de réalisation de parcours.
      * @param pathConfigState État actuel du parcours.
@@ -97,6 +156,12 @@ public:
      * @param dijkstra Instance de l'algorithme de Dijkstra utilisé pour le calcul de parcours.
      */
     void resetMakeJourneyRoutine(volatile PathConfigState &pathConfigState, Robot *robot, Dijkstra &dijkstra);
+
+    /**
+     * @brief Remet la sélection de destination à son état initial.
+     * @param pathConfigState État actuel de la configuration du parcours.
+     */
+    void resetSelectionRoutine(volatile PathConfigState &pathConfigState);
 };
 
 #endif
\ No newline at end of file
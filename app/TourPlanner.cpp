@@ -0,0 +1,154 @@
+/**
+ * @file TourPlanner.cpp
+ * @brief Implémentation de la classe TourPlanner.
+ *
+ * Ce fichier implémente la programmation dynamique sur les sous-ensembles de destinations qui
+ * détermine l'ordre de visite optimal d'une tournée.
+ */
+#include "TourPlanner.hpp"
+
+TourPlanner::TourPlanner()
+{
+}
+
+// Coût d'un état de la tournée pas encore atteint
+static const uint16_t UNREACHED = TIME_INF;
+
+// Somme de deux coûts, saturée juste sous UNREACHED
+static inline uint16_t addCosts(uint16_t a, uint16_t b)
+{
+    uint32_t sum = static_cast<uint32_t>(a) + b;
+    return (sum < UNREACHED) ? sum : UNREACHED - 1;
+}
+
+// Case de la table d'une orientation d'arrivée (une orientation inconnue partage la case du nord)
+static inline uint8_t getHeadingSlot(const CardinalDirection &heading)
+{
+    uint8_t index = toHeadingIndex(heading);
+    return (index < N_HEADINGS) ? index : 0;
+}
+
+uint16_t TourPlanner::planTour(Dijkstra &dijkstra, const Coordinate &start, const CardinalDirection &heading, const Coordinate destinations[],
+                               uint8_t count, uint8_t order[])
+{
+    if (count > MAX_TOUR_SIZE)
+        count = MAX_TOUR_SIZE;
+    if (count == 0)
+        return 0;
+
+    // Coûts des chemins depuis le départ, puis entre chaque paire de destinations pour chaque
+    // orientation de départ: l'orientation d'arrivée d'un trajet fixe le premier virage du suivant
+    uint16_t startCost[MAX_TOUR_SIZE];
+    uint8_t startHeading[MAX_TOUR_SIZE];
+    uint16_t cost[MAX_TOUR_SIZE][N_HEADINGS][MAX_TOUR_SIZE];
+    uint8_t arrivalHeading[MAX_TOUR_SIZE][N_HEADINGS][MAX_TOUR_SIZE];
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        CardinalDirection direction = heading;
+        startCost[i] = dijkstra.getRoadCost(start, destinations[i], direction);
+        startHeading[i] = getHeadingSlot(direction);
+        for (uint8_t h = 0; h < N_HEADINGS; ++h)
+        {
+            for (uint8_t j = 0; j < count; ++j)
+            {
+                direction = toHeading(h);
+                cost[i][h][j] = (i == j) ? TIME_INF : dijkstra.getRoadCost(destinations[i], destinations[j], direction);
+                arrivalHeading[i][h][j] = getHeadingSlot(direction);
+            }
+        }
+    }
+
+    // best[mask][last][h]: coût minimal pour visiter les destinations de mask en terminant par last
+    // avec l'orientation h (saturé à TIME_INF - 1 pour garder la table sur 16 bits); previous
+    // garde la destination et l'orientation précédentes (last * N_HEADINGS + h)
+    uint16_t best[N_TOUR_SUBSETS][MAX_TOUR_SIZE][N_HEADINGS];
+    uint8_t previous[N_TOUR_SUBSETS][MAX_TOUR_SIZE][N_HEADINGS];
+    uint8_t fullMask = (1 << count) - 1;
+    for (uint8_t mask = 0; mask <= fullMask; ++mask)
+    {
+        for (uint8_t last = 0; last < count; ++last)
+        {
+            for (uint8_t h = 0; h < N_HEADINGS; ++h)
+            {
+                best[mask][last][h] = UNREACHED;
+                previous[mask][last][h] = NO_NODE;
+            }
+        }
+    }
+    // Le graphe n'est pas orienté: une destination inaccessible du départ l'est de toute autre
+    uint8_t reachableMask = 0;
+    uint8_t nReachable = 0;
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        if (startCost[i] == TIME_INF)
+            continue;
+        best[1 << i][i][startHeading[i]] = startCost[i];
+        reachableMask |= 1 << i;
+        nReachable++;
+    }
+
+    // Les sous-ensembles sont traités par ordre croissant: chaque mask ne dépend que de ses sous-ensembles
+    for (uint8_t mask = 1; mask <= fullMask; ++mask)
+    {
+        for (uint8_t last = 0; last < count; ++last)
+        {
+            if (!(mask & (1 << last)))
+                continue;
+            for (uint8_t h = 0; h < N_HEADINGS; ++h)
+            {
+                if (best[mask][last][h] == UNREACHED)
+                    continue;
+                for (uint8_t next = 0; next < count; ++next)
+                {
+                    if ((mask & (1 << next)) || cost[last][h][next] == TIME_INF)
+                        continue;
+                    uint8_t nextMask = mask | (1 << next);
+                    uint8_t nextHeading = arrivalHeading[last][h][next];
+                    uint16_t candidate = addCosts(best[mask][last][h], cost[last][h][next]);
+                    if (candidate < best[nextMask][next][nextHeading])
+                    {
+                        best[nextMask][next][nextHeading] = candidate;
+                        previous[nextMask][next][nextHeading] = last * N_HEADINGS + h;
+                    }
+                }
+            }
+        }
+    }
+
+    // Meilleure dernière destination et orientation parmi les destinations accessibles
+    uint8_t last = 0;
+    uint8_t lastHeading = 0;
+    uint16_t bestCost = UNREACHED;
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        for (uint8_t h = 0; reachableMask != 0 && h < N_HEADINGS; ++h)
+        {
+            if (best[reachableMask][i][h] < bestCost)
+            {
+                bestCost = best[reachableMask][i][h];
+                last = i;
+                lastHeading = h;
+            }
+        }
+    }
+
+    // Remontée des prédécesseurs, puis les destinations inaccessibles en fin de tournée dans l'ordre de saisie
+    uint8_t mask = reachableMask;
+    for (uint8_t position = nReachable; position > 0; --position)
+    {
+        order[position - 1] = last;
+        uint8_t before = previous[mask][last][lastHeading];
+        mask &= ~(1 << last);
+        last = before / N_HEADINGS;
+        lastHeading = before % N_HEADINGS;
+    }
+    uint8_t position = nReachable;
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        if (!(reachableMask & (1 << i)))
+            order[position++] = i;
+    }
+    if (reachableMask != fullMask)
+        return TIME_INF;
+    return bestCost;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file TourPlanner.h
+ * @brief Définition de la classe TourPlanner pour l'ordonnancement d'une tournée.
+ *
+ * La classe TourPlanner détermine l'ordre de visite de plusieurs destinations qui minimise le coût
+ * total de la tournée, à partir des coûts des chemins calculés par Dijkstra.
+ */
+
+#ifndef TOUR_PLANNER_H
+#define TOUR_PLANNER_H
+
+#include "Dijkstra.hpp"
+#include "res/consts.hpp"
+
+/**
+ * @class TourPlanner
+ * @brief Classe calculant l'ordre de visite optimal d'une tournée.
+ *
+ * Le problème est résolu exactement par programmation dynamique sur les sous-ensembles de
+ * destinations déjà visitées (masque de bits). L'orientation du robot à l'arrivée d'une destination
+ * change le premier virage du trajet suivant: elle fait partie de l'état, et la table compte
+ * N_TOUR_SUBSETS x MAX_TOUR_SIZE x N_HEADINGS entrées. La tournée ne revient pas au point de départ.
+ */
+class TourPlanner
+{
+public:
+    /**
+     * @brief Constructeur par défaut de TourPlanner.
+     */
+    TourPlanner();
+
+    /**
+     * @brief Destructeur par défaut de TourPlanner.
+     */
+    ~TourPlanner() = default;
+
+    /**
+     * @brief Calcule l'ordre de visite qui minimise le coût total de la tournée.
+     * @param dijkstra L'algorithme qui fournit le coût des chemins entre deux points.
+     * @param start Le point de départ du robot.
+     * @param heading L'orientation du robot au point de départ.
+     * @param destinations Les destinations à visiter.
+     * @param count Le nombre de destinations (au plus MAX_TOUR_SIZE).
+     * @param order Tableau recevant les indices des destinations dans l'ordre de visite.
+     * @return uint16_t Le coût total de la tournée dans les unités du mode de planification (borné à
+     *         TIME_INF - 1), ou TIME_INF si une destination est inaccessible. Les destinations
+     *         accessibles sont alors ordonnées au mieux et les autres placées en fin de tournée.
+     */
+    uint16_t planTour(Dijkstra &dijkstra, const Coordinate &start, const CardinalDirection &heading, const Coordinate destinations[],
+                      uint8_t count, uint8_t order[]);
+};
+
+#endif // TOUR_PLANNER_H
@@ -1,49 +1,104 @@
 #ifndef CONSTS_H
 #define CONSTS_H
 #include <stdint.h>
+#include "res/enum/PlannerMode.hpp"
+#include "interfaces/consts_lib.hpp"
+#include "res/map.hpp"
+#include "interfaces/struct/Duration.hpp"
 
 //======================================================== Robot
-static const double DELAY_CORRECTION_MS = 0.5;
 static const uint8_t DELAY_MOST_CORRECTION_MS = 10;
 static const uint8_t DELAY_TO_GO_AHEAD_MS = 1;
-static const double DELAY_FIND_LINE_MS = 0.875;
-static const uint16_t DELAY_BEFORE_TURN_MS = 875;
-static const uint8_t MILLI_SECOND = 1;
-static const double SPEED = 0.45;
-static const double SPEED_TO_ADJUST_MS = 0.4;
-static const double SPEED_TO_MUST_ADJUST_MS = 0.3;
-static const double SPEED_TO_FIND_LINE = 0.35;
-static const uint16_t DELAY_TO_PLAY_SONG_MS = 1000;
-static const uint16_t MIDDLE_DELAY_SPOT_DETECTED_MS = 1000;
-static const uint8_t N_CYCLES_TO_BLINK_LED = 5;
-static const uint16_t DELAY_AFTER_FIND_LINE_MS = 350;
-static const uint16_t DELAY_STOP_BEFORE_TURN_MS = 350;
+static constexpr Milliseconds DELAY_BEFORE_TURN_MS = Milliseconds(875);
+static constexpr Milliseconds DELAY_BEFORE_POWER_DOWN_MS = Milliseconds(100); // Veille légère après un réveil, le temps de lire le bouton.
+static constexpr DutyCycle SPEED = toDutyCycle(0.45);
+static constexpr DutyCycle LINE_FOLLOW_CRUISE_DUTY = toDutyCycle(0.6); // Rapport cyclique des roues lorsque la ligne est centrée.
+static const int16_t LINE_PID_KP = toPidGain(0.9);                     // Gain proportionnel du suivi de ligne.
+static const int16_t LINE_PID_KI = toPidGain(0.02);                    // Gain intégral du suivi de ligne.
+static const int16_t LINE_PID_KD = toPidGain(2.5);                     // Gain dérivé du suivi de ligne.
+static const int16_t LINE_PID_INTEGRAL_LIMIT = 2000;                   // Borne de la somme des positions de la ligne.
+static constexpr Milliseconds DELAY_TO_PLAY_SONG_MS = Milliseconds(1000);
+static constexpr Milliseconds MIDDLE_DELAY_SPOT_DETECTED_MS = Milliseconds(1000);
+static constexpr Milliseconds DELAY_TO_DISPLAY_UNREACHABLE_MS = Milliseconds(2000); // Affichage d'une destination inaccessible.
+static constexpr Milliseconds IDENTIFY_BLINK_PERIOD_MS = Milliseconds(125); // Demi-période du clignotement pendant la recherche du coin.
+static constexpr Milliseconds DELAY_STOP_BEFORE_TURN_MS = Milliseconds(350);
 static const uint8_t MIN_SIZE_SCHEMA = 3;
-static const double DELAY_TO_TAKE_HALF_SEGMENT_MS = 1.25;
-static const double DELAY_TO_TAKE_SEGMENT_ROAD_MS = 1.7;
-static const double DELAY_BEFORE_TAKE_DECISION_S = 1.65;
-static const double DELAY_BEFORE_TAKE_CROSS_DECISION_S = 1.25;
-static const double DELAY_BEFORE_TAKE_LOST_DECISION_S = 1.1;
-static const double DELAY_TO_TAKE_SEGMENT_MS = 2.25;
-static const uint16_t DELAY_TO_STOP_ENGINE_FOR_BACK_MS = 350;
-static const uint8_t DELAY_TO_SKIP_CROSS_NOT_NECESSARY_MS = 200;
+static constexpr Seconds DELAY_TO_TAKE_HALF_SEGMENT_S = Seconds(1.25);
+static constexpr Seconds DELAY_TO_TAKE_SEGMENT_ROAD_S = Seconds(1.7);
+static constexpr Seconds DELAY_BEFORE_TAKE_DECISION_S = Seconds(1.65);
+static constexpr Seconds DELAY_BEFORE_TAKE_CROSS_DECISION_S = Seconds(1.25);
+static constexpr Seconds DELAY_BEFORE_TAKE_LOST_DECISION_S = Seconds(1.1);
+static constexpr Seconds DELAY_TO_TAKE_SEGMENT_S = Seconds(2.25);
+static constexpr Milliseconds DELAY_TO_STOP_ENGINE_FOR_BACK_MS = Milliseconds(350);
+static constexpr Milliseconds DELAY_TO_SKIP_CROSS_NOT_NECESSARY_MS = Milliseconds(200);
 static const uint8_t NOTE_IF_CORNER_FOUND = 81;
-static const uint8_t MAX_COlS_VALUE = 7;
-static const uint8_t MAX_ROW_VALUE = 4;
+static const uint8_t MAX_COlS_VALUE = MAP_COLUMNS;
+static const uint8_t MAX_ROW_VALUE = MAP_ROWS;
 static const uint8_t N_TIME_TO_PLAY_SONG = 5;
-static const uint8_t DELAY_200_MS = 200;
-static const uint8_t DELAY_100_MS = 100;
+static constexpr Milliseconds DELAY_200_MS = Milliseconds(200);
+static constexpr Milliseconds DELAY_100_MS = Milliseconds(100);
 static const uint8_t NOTE_IF_OBSTACLE_DETECTED = 56;
-static const uint16_t DELAY_TO_AJUST_IF_OBSTACLE_DETECTED = 550;
+static constexpr Milliseconds DELAY_TO_AJUST_IF_OBSTACLE_DETECTED = Milliseconds(550);
 static const uint8_t SPEED_IMPULSION = 1;
 static const uint8_t DELAY_FOR_IMPULSION = 10;
-const uint8_t DELAY_AJUST_WHILE_RUNNING = 50;
+static constexpr Milliseconds DELAY_AJUST_WHILE_RUNNING = Milliseconds(50);
+static constexpr Seconds DELAY_BEFORE_ARC_TURN_S = Seconds(0.6);                            // Avance après la croix avant d'engager un virage en arc.
+static constexpr Milliseconds CROSS_PASS_TIMEOUT_MS = Milliseconds(500);                    // Durée maximale de la traversée d'une croix en ligne droite.
+static constexpr Milliseconds DELAY_ARC_LEAVE_LINE_MS = Milliseconds(300);                  // Durée minimale de l'arc pour quitter la ligne courante.
+static constexpr Milliseconds ARC_TURN_TIMEOUT_MS = Milliseconds(1500);                     // Durée maximale de l'arc avant de chercher la ligne sur place.
+static constexpr Milliseconds TURN_90_TIMEOUT_MS = Milliseconds(2 * DELAY_TURN_90_DEGRE);   // Durée maximale d'une rotation de 90 degrés.
+static constexpr Milliseconds TURN_180_TIMEOUT_MS = Milliseconds(2 * DELAY_TURN_180_DEGRE); // Durée maximale d'un demi-tour.
 //======================================================== Dijkstra
-static const uint8_t SIZE = 28; // Taille de la matrice d'adjacence.
-static const uint8_t INF = 200; // Valeur infinie utilisée pour l'initialisation de la matrice.
+static const uint8_t SIZE = MAP_ROWS * MAP_COLUMNS;             // Nombre de points du graphe de navigation.
+static const uint8_t N_EDGES = countMapEdges();                 // Nombre de segments du graphe de navigation.
+static const uint8_t BLOCKED_MASK_SIZE = (N_EDGES + 7) / 8;     // Taille en octets du masque des segments bloqués.
+static const uint8_t INF = 200;                                 // Valeur infinie utilisée pour les distances.
+static const uint8_t NO_NEXT_HOP = 0xFF;                        // Absence de prochain saut dans la table des chemins.
+static const uint8_t NO_NODE = 0xFF;                            // Indice invalide de point du graphe.
+static const uint8_t MAX_EDGE_COST = getMaxMapEdgeCost();       // Plus grand coût d'un segment de la carte.
+// Nombre de seaux de la file de Dial (puissance de 2 > MAX_EDGE_COST + 1, écart maximal de f entre deux points).
+static const uint8_t N_BUCKETS = 8;
+static const uint8_t N_HEADINGS = 4;                            // Nombre d'orientations possibles du robot en un point.
+static const uint8_t N_STATES = SIZE * N_HEADINGS;              // Nombre d'états (point, orientation) du graphe.
+
+// Les ensembles de points (file de LPA*, seaux de Dial) tiennent sur 32 bits.
+static_assert(MAP_ROWS * MAP_COLUMNS <= 32, "La carte depasse 32 points");
+// Les états (point, orientation) sont numérotés sur 8 bits, NO_NODE exclu.
+static_assert(MAP_ROWS * MAP_COLUMNS * N_HEADINGS < NO_NODE, "Les etats (point, orientation) depassent NO_NODE");
+// Les distances et les clés f = g + h de la recherche sont sur 8 bits: le pire chemin simple doit rester sous INF.
+static_assert((SIZE - 1) * MAX_EDGE_COST + (MAP_ROWS - 1) + (MAP_COLUMNS - 1) < INF, "Le cout du pire chemin depasse INF");
+static const uint16_t TIME_INF = 0xFFFF;                        // Temps de parcours infini (état inaccessible).
+// Temps de parcours d'un segment de coût 1 (budget alloué a un segment par le chrono).
+static const uint16_t SEGMENT_UNIT_TIME_MS = Milliseconds(DELAY_TO_TAKE_SEGMENT_ROAD_S).count();
+// Poids des nouvelles mesures dans la moyenne mobile exponentielle des temps de segment (1 / 2^n).
+static const uint8_t EDGE_TIME_EMA_SHIFT = 2;
+// Temps de parcours correspondant a une unite de cout appris.
+static const uint16_t EDGE_COST_UNIT_MS = SEGMENT_UNIT_TIME_MS;
+// Delai accorde pour un segment deja mesure, en pourcentage de son temps appris.
+static const uint8_t SEGMENT_TIMEOUT_MARGIN_PERCENT = 150;
+// Delai maximal accorde a un segment (limite des minuteries du chrono).
+static const uint16_t MAX_SEGMENT_TIMEOUT_MS = TIMER_WHEEL_MAX_DELAY_MS;
+// Temps perdu a chaque arret a une intersection (demi-tour): arret, petite avance puis arret avant la decision.
+static const uint16_t NODE_CROSSING_TIME_MS = 3 * DELAY_AJUST_WHILE_RUNNING.count();
+// Temps d'un virage sur place: arret puis rotation jusqu'a la ligne visee.
+static const uint16_t TURN_90_TIME_MS = DELAY_STOP_BEFORE_TURN_MS.count() + DELAY_TURN_90_DEGRE;
+static const uint16_t TURN_180_TIME_MS = DELAY_STOP_BEFORE_TURN_MS.count() + DELAY_TURN_180_DEGRE;
+// Temps estimé d'un virage de 90 degrés en arc, sans arrêt, jusqu'à la recapture de la ligne.
+static const uint16_t ARC_TURN_90_TIME_MS = 2 * DELAY_ARC_LEAVE_LINE_MS.count();
 //======================================================== RobotManager
-const uint16_t DELAY_BEFORE_START_IDENTIFY_CORNER_MS = 2000;
+static constexpr Milliseconds DELAY_BEFORE_START_IDENTIFY_CORNER_MS = Milliseconds(2000);
 const uint8_t N_ROAD = 3;
+// Algorithme de planification des trajets. INCREMENTAL lit la table précalculée tant que rien n'est
+// bloqué; TRAVEL_TIME (virages comptés) recherche à chaque trajet et doit être choisi explicitement.
+const PlannerMode JOURNEY_PLANNER_MODE = PlannerMode::INCREMENTAL;
+//======================================================== TourPlanner
+const uint8_t MAX_TOUR_SIZE = N_ROAD;                   // Nombre maximal de destinations d'une tournée.
+const uint8_t N_TOUR_SUBSETS = 1 << MAX_TOUR_SIZE;      // Nombre de sous-ensembles de destinations visitées.
+//======================================================== ObstacleMap
+const uint16_t OBSTACLE_MAP_ADDRESS = 0x0000;     // Adresse de la carte des obstacles en mémoire externe.
+const uint8_t OBSTACLE_MAP_MAGIC = 0xB5;          // Marque d'une carte des obstacles formatée.
+const uint8_t OBSTACLE_MAX_CONFIDENCE = 4;        // Confiance maximale d'un obstacle.
+const uint8_t OBSTACLE_RUNS_PER_CONFIDENCE = 3;   // Parcours pendant lesquels chaque détection reste valide.
 //======================================================== SearchEngine
 
 #endif
\ No newline at end of file
@@ -0,0 +1,38 @@
+/**
+ * @file InputEvent.h
+ * @brief Définition de l'énumération InputEvent pour les événements des boutons.
+ *
+ * L'anti-rebond des boutons (ButtonDebouncer) dépose ces événements dans une EventQueue depuis
+ * l'interruption du timer 0; RobotManager les traite dans la boucle principale.
+ */
+
+#ifndef INPUT_EVENT_H
+#define INPUT_EVENT_H
+
+#include <stdint.h>
+#include "interfaces/emun/ButtonEvent.hpp"
+
+/**
+ * @enum InputEvent
+ * @brief Énumération des événements des boutons.
+ *
+ * Chaque bouton occupe trois codes consécutifs, dans l'ordre de ButtonEvent: le code déposé par
+ * ButtonDebouncer est le premier code du bouton plus l'événement.
+ */
+enum class InputEvent : uint8_t
+{
+    MOTHER_BOARD_PRESSED,      // Appui sur le bouton de la carte mère.
+    MOTHER_BOARD_LONG_PRESSED, // Appui long sur le bouton de la carte mère.
+    MOTHER_BOARD_REPEATED,     // Répétition du bouton de la carte mère maintenu.
+    VALIDATION_PRESSED,        // Appui sur le bouton de validation.
+    VALIDATION_LONG_PRESSED,   // Appui long sur le bouton de validation.
+    VALIDATION_REPEATED,       // Répétition du bouton de validation maintenu.
+    SELECTION_PRESSED,         // Appui sur le bouton de sélection.
+    SELECTION_LONG_PRESSED,    // Appui long sur le bouton de sélection.
+    SELECTION_REPEATED         // Répétition du bouton de sélection maintenu.
+};
+
+static_assert(static_cast<uint8_t>(InputEvent::VALIDATION_REPEATED) - static_cast<uint8_t>(InputEvent::VALIDATION_PRESSED) == static_cast<uint8_t>(ButtonEvent::REPEATED),
+              "InputEvent doit suivre l'ordre de ButtonEvent");
+
+#endif // INPUT_EVENT_H
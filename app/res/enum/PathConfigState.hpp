@@ -17,6 +17,9 @@
  * Cette énumération représente les différentes étapes ou états que le robot peut traverser lors de
  * la préparation et de l'exécution de son parcours au niveau de la configuration sur le LCD pour le choix
  * du point de destination, allant de l'initialisation à la finalisation du point de destination.
+ *
+ * Les états composites regroupent les transitions communes à leurs sous-états dans la machine à
+ * états hiérarchique de RobotManager; ils ne sont jamais l'état courant.
  */
 enum class PathConfigState
 {
@@ -27,7 +30,11 @@ enum class PathConfigState
 	CONFIRMATION,	   // Confirmation des choix de ligne et de colonne.
 	INIT_CONFIRMATION, // Debut de l'etape de confirmation.
 	RESET,			   // Réinitialisation du choix du point de destination.
-	FINALIZED		   // Finalisation du choix du points de destination (choix validé).
+	FINALIZED,		   // Finalisation du choix du points de destination (choix validé).
+	ROW_ENTRY,		   // Composite: saisie de la ligne (INIT_ROW, SELECT_ROW).
+	COLUMN_ENTRY,	   // Composite: saisie de la colonne (INIT_COL, SELECT_COLUMN).
+	CONFIRMATION_ENTRY, // Composite: confirmation (INIT_CONFIRMATION, CONFIRMATION).
+	DESTINATION_ENTRY  // Composite racine: saisie du point de destination.
 };
 
 #endif // PATH_CONFIG_STATE_H
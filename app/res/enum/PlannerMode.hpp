@@ -0,0 +1,29 @@
+/**
+ * @file PlannerMode.h
+ * @brief Définition de l'énumération PlannerMode pour le choix de l'algorithme de planification.
+ *
+ * Ce fichier contient l'énumération PlannerMode, qui permet de choisir l'algorithme utilisé par
+ * la classe Dijkstra pour recalculer un chemin lorsque des segments de la carte sont bloqués.
+ */
+
+#ifndef PLANNER_MODE_H
+#define PLANNER_MODE_H
+
+/**
+ * @enum PlannerMode
+ * @brief Énumération des algorithmes de planification disponibles.
+ *
+ * Pour les modes qui minimisent le coût des segments, le chemin est lu dans la table précalculée
+ * lorsque aucun segment n'est bloqué; le mode ne s'applique alors qu'aux recherches effectuées après
+ * la détection d'un obstacle. Le mode TRAVEL_TIME minimise plutôt le temps de parcours réel
+ * (virages compris) et effectue toujours sa recherche.
+ */
+enum class PlannerMode
+{
+    LINEAR_SCAN, // Dijkstra complet à chaque appel (recherche linéaire du minimum).
+    INCREMENTAL,  // Replanification incrémentale (LPA*) qui conserve son état entre les appels.
+    TRAVEL_TIME,  // Dijkstra sur les états (point, orientation) avec des coûts en millisecondes.
+    BUCKET_ASTAR  // A* avec file à seaux (Dial) et heuristique de Manhattan, arrêt à l'arrivée.
+};
+
+#endif // PLANNER_MODE_H
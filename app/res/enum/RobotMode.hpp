@@ -22,7 +22,8 @@ enum class RobotMode
 {
 	UNDEFINED,		 // Mode non défini ou état initial.
 	IDENTIFY_CORNER, // Mode pour identifier les coins dans l'environnement.
-	MAKE_JOURNEY	 // Mode pour réaliser un parcours spécifié.
+	MAKE_JOURNEY,	 // Mode pour réaliser un parcours spécifié.
+	MAKE_TOUR		 // Mode pour réaliser une tournée de plusieurs destinations saisies d'avance.
 };
 
 #endif // ROBOT_MODE_H
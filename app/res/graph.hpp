@@ -0,0 +1,143 @@
+/**
+ * @file graph.h
+ * @brief Définition du graphe de navigation stocké en mémoire flash.
+ *
+ * Ce fichier contient la table des segments, générée à partir du dessin de la carte (res/map.hpp),
+ * ainsi que la liste d'adjacence compacte (CSR) qui en est dérivée. Les deux tables sont
+ * construites à la compilation et placées en mémoire flash (PROGMEM) afin de libérer la SRAM du
+ * microcontrôleur. Elles doivent être lues avec les fonctions pgm_read_*. La table des prochains
+ * sauts pour toutes les paires de points est aussi calculée à la compilation pour éviter une recherche lorsque aucun segment n'est bloqué.
+ */
+
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <avr/pgmspace.h>
+#include "res/struct/EdgeList.hpp"
+#include "res/struct/AdjacencyList.hpp"
+#include "res/struct/NextHopTable.hpp"
+#include "res/consts.hpp"
+
+/**
+ * @brief Construit la table des segments en lisant le dessin de la carte ligne par ligne.
+ *
+ * Évaluée à la compilation : aucun code n'est généré pour cette fonction.
+ *
+ * @return EdgeList La table des segments de la carte.
+ */
+constexpr EdgeList buildEdgeList()
+{
+    EdgeList list = {};
+    uint8_t e = 0;
+    for (uint8_t line = 0; line < MAP_LAYOUT_HEIGHT; ++line)
+    {
+        for (uint8_t column = 0; column < MAP_LAYOUT_WIDTH; ++column)
+        {
+            uint8_t cost = getLayoutEdgeCost(line, column);
+            if (!isLayoutEdgeCell(line, column) || cost == 0)
+                continue;
+            // Le premier point est celui du haut (segment vertical) ou de gauche (segment horizontal)
+            uint8_t node1 = (line / 2) * MAP_COLUMNS + column / 2;
+            uint8_t node2 = (line % 2 == 1) ? node1 + MAP_COLUMNS : node1 + 1;
+            list.edges[e++] = Edge{node1, node2, cost};
+        }
+    }
+    return list;
+}
+
+/**
+ * @brief Table des segments de la carte avec leur coût, en mémoire flash.
+ *
+ * L'indice d'un segment dans cette table est son identifiant. Le graphe est non orienté.
+ */
+constexpr EdgeList edgeList PROGMEM = buildEdgeList();
+
+static_assert((N_BUCKETS & (N_BUCKETS - 1)) == 0 && N_BUCKETS > MAX_EDGE_COST + 1, "N_BUCKETS doit couvrir l'ecart maximal de f");
+
+/**
+ * @brief Construit la liste d'adjacence compacte à partir de la table des segments.
+ *
+ * Évaluée à la compilation : aucun code n'est généré pour cette fonction.
+ *
+ * @return AdjacencyList La liste d'adjacence du graphe.
+ */
+constexpr AdjacencyList buildAdjacencyList()
+{
+    AdjacencyList list = {};
+    // Compte le nombre de voisins de chaque point
+    for (uint8_t e = 0; e < N_EDGES; ++e)
+    {
+        list.offsets[edgeList.edges[e].node1 + 1]++;
+        list.offsets[edgeList.edges[e].node2 + 1]++;
+    }
+    // Somme cumulative pour obtenir le début de la liste de chaque point
+    for (uint8_t n = 0; n < SIZE; ++n)
+        list.offsets[n + 1] += list.offsets[n];
+
+    uint8_t next[SIZE] = {};
+    for (uint8_t n = 0; n < SIZE; ++n)
+        next[n] = list.offsets[n];
+    for (uint8_t e = 0; e < N_EDGES; ++e)
+    {
+        list.arcs[next[edgeList.edges[e].node1]++] = Arc{edgeList.edges[e].node2, e};
+        list.arcs[next[edgeList.edges[e].node2]++] = Arc{edgeList.edges[e].node1, e};
+    }
+    return list;
+}
+
+/**
+ * @brief Liste d'adjacence compacte du graphe de navigation, en mémoire flash.
+ */
+constexpr AdjacencyList adjacency PROGMEM = buildAdjacencyList();
+
+/**
+ * @brief Construit la table des prochains sauts avec l'algorithme de Floyd-Warshall.
+ *
+ * Évaluée à la compilation : aucun code n'est généré pour cette fonction.
+ *
+ * @return NextHopTable La table des prochains sauts du graphe sans obstacle.
+ */
+constexpr NextHopTable buildNextHopTable()
+{
+    NextHopTable table = {};
+    uint8_t distance[SIZE][SIZE] = {};
+    for (uint8_t i = 0; i < SIZE; ++i)
+    {
+        for (uint8_t j = 0; j < SIZE; ++j)
+        {
+            distance[i][j] = (i == j) ? 0 : INF;
+            table.next[i][j] = NO_NEXT_HOP;
+        }
+    }
+    for (uint8_t e = 0; e < N_EDGES; ++e)
+    {
+        distance[edgeList.edges[e].node1][edgeList.edges[e].node2] = edgeList.edges[e].cost;
+        distance[edgeList.edges[e].node2][edgeList.edges[e].node1] = edgeList.edges[e].cost;
+        table.next[edgeList.edges[e].node1][edgeList.edges[e].node2] = edgeList.edges[e].node2;
+        table.next[edgeList.edges[e].node2][edgeList.edges[e].node1] = edgeList.edges[e].node1;
+    }
+    for (uint8_t k = 0; k < SIZE; ++k)
+    {
+        for (uint8_t i = 0; i < SIZE; ++i)
+        {
+            if (distance[i][k] == INF)
+                continue;
+            for (uint8_t j = 0; j < SIZE; ++j)
+            {
+                if (distance[k][j] != INF && distance[i][k] + distance[k][j] < distance[i][j])
+                {
+                    distance[i][j] = distance[i][k] + distance[k][j];
+                    table.next[i][j] = table.next[i][k];
+                }
+            }
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Table des prochains sauts sans obstacle, en mémoire flash.
+ */
+constexpr NextHopTable nextHops PROGMEM = buildNextHopTable();
+
+#endif // GRAPH_H
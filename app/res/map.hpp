@@ -0,0 +1,240 @@
+/**
+ * @file map.h
+ * @brief Description déclarative de la carte du parcours.
+ *
+ * La carte est décrite une seule fois, sous forme de dessin: dimensions de la grille, segments,
+ * coûts et murs. Toutes les tables de navigation (segments, liste d'adjacence, table des prochains
+ * sauts) en sont dérivées à la compilation (voir res/graph.hpp). Un nouveau parcours ne demande
+ * donc que de modifier MAP_LAYOUT et de recompiler.
+ */
+
+#ifndef MAP_H
+#define MAP_H
+
+#include <stdint.h>
+#include "res/struct/Coordinates.hpp"
+#include "res/enum/Cardinal.hpp"
+
+constexpr uint8_t MAP_ROWS = 4;                           // Nombre de lignes de points de la grille.
+constexpr uint8_t MAP_COLUMNS = 7;                        // Nombre de colonnes de points de la grille.
+constexpr uint8_t MAP_LAYOUT_HEIGHT = 2 * MAP_ROWS - 1;   // Nombre de lignes du dessin de la carte.
+constexpr uint8_t MAP_LAYOUT_WIDTH = 2 * MAP_COLUMNS - 1; // Nombre de caractères par ligne du dessin.
+constexpr char MAP_NODE = 'o';                            // Caractère d'un point de la grille.
+constexpr char MAP_WALL = ' ';                            // Caractère d'un mur (absence de segment).
+
+/**
+ * @brief Dessin de la carte, une chaîne par ligne.
+ *
+ * Les lignes paires contiennent les points ('o') séparés par les segments horizontaux. Les lignes
+ * impaires contiennent les segments verticaux, sous chaque point. Un segment est noté par son coût
+ * (chiffre de 1 à 9), un mur par un espace. Le point (1, 1) est en haut à gauche et le nord est
+ * vers le haut.
+ */
+constexpr char MAP_LAYOUT[] =
+    "o1o1o1o o1o2o"
+    "1   1 1   2 1"
+    "o5o1o o2o1o1o"
+    "  1 5   5 1 1"
+    "o2o1o1o5o o o"
+    "5   1 1 5 1 1"
+    "o1o1o o2o5o1o";
+
+static_assert(sizeof(MAP_LAYOUT) - 1 == MAP_LAYOUT_HEIGHT * MAP_LAYOUT_WIDTH, "MAP_LAYOUT ne correspond pas aux dimensions de la grille");
+
+/**
+ * @brief Retourne un caractère du dessin de la carte.
+ * @param line La ligne du dessin.
+ * @param column La colonne du dessin.
+ * @return char Le caractère à cette position.
+ */
+constexpr char getLayoutCell(uint8_t line, uint8_t column)
+{
+    return MAP_LAYOUT[line * MAP_LAYOUT_WIDTH + column];
+}
+
+/**
+ * @brief Indique si une case du dessin représente un segment (entre deux points voisins).
+ * @param line La ligne du dessin.
+ * @param column La colonne du dessin.
+ * @return true si la case est entre deux points voisins.
+ */
+constexpr bool isLayoutEdgeCell(uint8_t line, uint8_t column)
+{
+    return (line + column) % 2 == 1;
+}
+
+/**
+ * @brief Retourne le coût du segment dessiné dans une case, ou 0 s'il s'agit d'un mur.
+ * @param line La ligne du dessin.
+ * @param column La colonne du dessin.
+ * @return uint8_t Le coût du segment.
+ */
+constexpr uint8_t getLayoutEdgeCost(uint8_t line, uint8_t column)
+{
+    return (getLayoutCell(line, column) == MAP_WALL) ? 0 : getLayoutCell(line, column) - '0';
+}
+
+/**
+ * @brief Vérifie que chaque case du dessin contient un caractère attendu à sa position.
+ * @return true si le dessin est valide.
+ */
+constexpr bool isMapLayoutValid()
+{
+    for (uint8_t line = 0; line < MAP_LAYOUT_HEIGHT; ++line)
+    {
+        for (uint8_t column = 0; column < MAP_LAYOUT_WIDTH; ++column)
+        {
+            char cell = getLayoutCell(line, column);
+            if (line % 2 == 0 && column % 2 == 0)
+            {
+                if (cell != MAP_NODE)
+                    return false;
+            }
+            else if (!isLayoutEdgeCell(line, column))
+            {
+                if (cell != MAP_WALL)
+                    return false;
+            }
+            else if (cell != MAP_WALL && (cell < '1' || cell > '9'))
+                return false;
+        }
+    }
+    return true;
+}
+
+static_assert(isMapLayoutValid(), "MAP_LAYOUT contient un caractere invalide");
+
+/**
+ * @brief Compte les segments dessinés sur la carte.
+ * @return uint8_t Le nombre de segments.
+ */
+constexpr uint8_t countMapEdges()
+{
+    uint8_t count = 0;
+    for (uint8_t line = 0; line < MAP_LAYOUT_HEIGHT; ++line)
+    {
+        for (uint8_t column = 0; column < MAP_LAYOUT_WIDTH; ++column)
+        {
+            if (isLayoutEdgeCell(line, column) && getLayoutEdgeCost(line, column) != 0)
+                count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Retourne le plus grand coût de segment dessiné sur la carte.
+ * @return uint8_t Le coût maximal.
+ */
+constexpr uint8_t getMaxMapEdgeCost()
+{
+    uint8_t maxCost = 0;
+    for (uint8_t line = 0; line < MAP_LAYOUT_HEIGHT; ++line)
+    {
+        for (uint8_t column = 0; column < MAP_LAYOUT_WIDTH; ++column)
+        {
+            if (isLayoutEdgeCell(line, column) && getLayoutEdgeCost(line, column) > maxCost)
+                maxCost = getLayoutEdgeCost(line, column);
+        }
+    }
+    return maxCost;
+}
+
+/**
+ * @brief Calcule une signature du dessin de la carte.
+ *
+ * Les données qui dépendent des identifiants de segments (carte des obstacles en mémoire externe)
+ * sont invalidées lorsque la signature change.
+ *
+ * @return uint8_t La signature de MAP_LAYOUT.
+ */
+constexpr uint8_t getMapSignature()
+{
+    uint8_t signature = MAP_ROWS ^ (MAP_COLUMNS << 4);
+    for (uint8_t i = 0; i < MAP_LAYOUT_HEIGHT * MAP_LAYOUT_WIDTH; ++i)
+        signature = static_cast<uint8_t>((signature << 1) | (signature >> 7)) ^ MAP_LAYOUT[i];
+    return signature;
+}
+
+/**
+ * @brief Indique si des coordonnées sont sur la grille.
+ * @param coordinate Les coordonnées (à partir de 1).
+ * @return true si le point existe.
+ */
+constexpr bool isOnMap(const Coordinate &coordinate)
+{
+    return coordinate.row >= 1 && coordinate.row <= MAP_ROWS && coordinate.column >= 1 && coordinate.column <= MAP_COLUMNS;
+}
+
+/**
+ * @brief Convertit des coordonnées en indice de point (numérotation ligne par ligne).
+ * @param coordinate Les coordonnées, qui doivent être sur la grille.
+ * @return uint8_t L'indice du point.
+ */
+constexpr uint8_t toNodeIndex(const Coordinate &coordinate)
+{
+    return (coordinate.row - 1) * MAP_COLUMNS + (coordinate.column - 1);
+}
+
+/**
+ * @brief Convertit un indice de point en coordonnées.
+ * @param node L'indice du point.
+ * @return Coordinate Les coordonnées du point.
+ */
+constexpr Coordinate toCoordinate(uint8_t node)
+{
+    return Coordinate{static_cast<int8_t>(node / MAP_COLUMNS + 1), static_cast<int8_t>(node % MAP_COLUMNS + 1)};
+}
+
+/**
+ * @brief Convertit une direction de navigation en indice d'orientation.
+ * Les indices suivent l'ordre de Cardinal; deux orientations opposées ont des indices dont la somme vaut 3.
+ * @param direction La direction (NORTH, EAST, WEST ou SOUTH).
+ * @return uint8_t L'indice d'orientation, de 0 à 3.
+ */
+constexpr uint8_t toHeadingIndex(CardinalDirection direction)
+{
+    return static_cast<uint8_t>(direction) - static_cast<uint8_t>(CardinalDirection::NORTH);
+}
+
+/**
+ * @brief Convertit un indice d'orientation en direction de navigation.
+ * @param index L'indice d'orientation, de 0 à 3.
+ * @return CardinalDirection La direction correspondante.
+ */
+constexpr CardinalDirection toHeading(uint8_t index)
+{
+    return static_cast<CardinalDirection>(static_cast<uint8_t>(CardinalDirection::NORTH) + index);
+}
+
+/**
+ * @brief Indique si un segment part d'un point dans une direction donnée.
+ * @param from Les coordonnées du point.
+ * @param orientation La direction du segment.
+ * @return true si un segment existe dans cette direction.
+ */
+constexpr bool hasMapRoad(const Coordinate &from, Cardinal orientation)
+{
+    int8_t line = 2 * (from.row - 1);
+    int8_t column = 2 * (from.column - 1);
+    switch (orientation)
+    {
+    case Cardinal::NORTH:
+        line--;
+        break;
+    case Cardinal::SOUTH:
+        line++;
+        break;
+    case Cardinal::EAST:
+        column++;
+        break;
+    case Cardinal::WEST:
+        column--;
+        break;
+    }
+    if (!isOnMap(from) || line < 0 || column < 0 || line >= MAP_LAYOUT_HEIGHT || column >= MAP_LAYOUT_WIDTH)
+        return false;
+    return getLayoutCell(line, column) != MAP_WALL;
+}
+
+#endif // MAP_H
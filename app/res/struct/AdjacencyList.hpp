@@ -0,0 +1,29 @@
+/**
+ * @file AdjacencyList.h
+ * @brief Définition de la structure AdjacencyList pour représenter le graphe de navigation.
+ *
+ * Ce fichier contient la définition de la structure AdjacencyList, une liste d'adjacence au
+ * format compact CSR (Compressed Sparse Row) qui remplace la matrice d'adjacence complète.
+ */
+
+#ifndef ADJACENCY_LIST_H
+#define ADJACENCY_LIST_H
+
+#include <stdint.h>
+#include "res/struct/Arc.hpp"
+#include "res/consts.hpp"
+
+/**
+ * @struct AdjacencyList
+ * @brief Liste d'adjacence compacte (CSR) du graphe de navigation.
+ *
+ * Les voisins du point n occupent les entrées arcs[offsets[n]] à arcs[offsets[n + 1] - 1].
+ * La structure est construite à la compilation et placée en mémoire flash.
+ */
+struct AdjacencyList
+{
+    uint8_t offsets[SIZE + 1]; // Début de la liste des voisins de chaque point.
+    Arc arcs[2 * N_EDGES];     // Voisins de tous les points, regroupés par point.
+};
+
+#endif // ADJACENCY_LIST_H
@@ -0,0 +1,27 @@
+/**
+ * @file Arc.h
+ * @brief Définition de la structure Arc pour représenter un voisin dans la liste d'adjacence.
+ *
+ * Ce fichier contient la définition de la structure Arc, qui représente une entrée de la liste
+ * d'adjacence compacte (CSR) du graphe de navigation.
+ */
+
+#ifndef ARC_H
+#define ARC_H
+
+#include <stdint.h>
+
+/**
+ * @struct Arc
+ * @brief Structure représentant un arc orienté vers un voisin dans la liste d'adjacence.
+ *
+ * Chaque segment non orienté de la carte produit deux arcs, un pour chaque extrémité. L'arc
+ * conserve l'identifiant du segment afin de retrouver son coût et son état (bloqué ou non).
+ */
+struct Arc
+{
+    uint8_t neighbor; // Indice du point voisin.
+    uint8_t edge;     // Identifiant du segment dans la table des segments.
+};
+
+#endif // ARC_H
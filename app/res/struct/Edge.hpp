@@ -0,0 +1,28 @@
+/**
+ * @file Edge.h
+ * @brief Définition de la structure Edge pour représenter un segment de la carte.
+ *
+ * Ce fichier contient la définition de la structure Edge, utilisée pour décrire un segment
+ * (arête non orientée) entre deux points de navigation ainsi que son coût de parcours.
+ */
+
+#ifndef EDGE_H
+#define EDGE_H
+
+#include <stdint.h>
+
+/**
+ * @struct Edge
+ * @brief Structure représentant un segment non orienté entre deux points de la carte.
+ *
+ * Les segments sont stockés en mémoire flash et sont identifiés par leur position dans la
+ * table des segments. Cet identifiant sert d'indice dans le masque des segments bloqués.
+ */
+struct Edge
+{
+    uint8_t node1; // Indice du premier point du segment.
+    uint8_t node2; // Indice du second point du segment.
+    uint8_t cost;  // Coût de parcours du segment.
+};
+
+#endif // EDGE_H
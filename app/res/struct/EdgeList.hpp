@@ -0,0 +1,27 @@
+/**
+ * @file EdgeList.h
+ * @brief Définition de la structure EdgeList regroupant les segments de la carte.
+ *
+ * Ce fichier contient la définition de la structure EdgeList, la table des segments générée à la
+ * compilation à partir de la description de la carte (voir res/map.hpp).
+ */
+
+#ifndef EDGE_LIST_H
+#define EDGE_LIST_H
+
+#include "res/struct/Edge.hpp"
+#include "res/consts.hpp"
+
+/**
+ * @struct EdgeList
+ * @brief Table des segments de la carte.
+ *
+ * L'indice d'un segment dans cette table est son identifiant. La structure est construite à la
+ * compilation et placée en mémoire flash.
+ */
+struct EdgeList
+{
+    Edge edges[N_EDGES]; // Segments de la carte, dans l'ordre de lecture du dessin.
+};
+
+#endif // EDGE_LIST_H
@@ -0,0 +1,28 @@
+/**
+ * @file MotionPrimitive.h
+ * @brief Définition de la structure MotionPrimitive pour représenter une ligne droite du parcours.
+ *
+ * Ce fichier contient la définition de la structure MotionPrimitive, l'élément d'un parcours encodé
+ * par plages (RoadPlan): une direction suivie sur plusieurs segments consécutifs.
+ */
+
+#ifndef MOTION_PRIMITIVE_H
+#define MOTION_PRIMITIVE_H
+
+#include <stdint.h>
+#include "res/enum/Cardinal.hpp"
+
+/**
+ * @struct MotionPrimitive
+ * @brief Structure représentant une ligne droite de plusieurs intersections.
+ *
+ * Le robot suit la direction sans s'arrêter aux nIntersections - 1 premières intersections, puis
+ * s'arrête à la dernière pour tourner vers la direction de la primitive suivante.
+ */
+struct MotionPrimitive
+{
+    CardinalDirection direction; // Direction suivie pendant toute la ligne droite.
+    uint8_t nIntersections;      // Nombre de segments parcourus (intersections atteintes).
+};
+
+#endif // MOTION_PRIMITIVE_H
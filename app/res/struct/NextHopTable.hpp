@@ -0,0 +1,27 @@
+/**
+ * @file NextHopTable.h
+ * @brief Définition de la structure NextHopTable pour les plus courts chemins précalculés.
+ *
+ * Ce fichier contient la définition de la structure NextHopTable, qui mémorise pour chaque paire
+ * de points (départ, arrivée) le prochain point à visiter sur un plus court chemin.
+ */
+
+#ifndef NEXT_HOP_TABLE_H
+#define NEXT_HOP_TABLE_H
+
+#include <stdint.h>
+#include "res/consts.hpp"
+
+/**
+ * @struct NextHopTable
+ * @brief Table des prochains sauts pour toutes les paires de points du graphe.
+ *
+ * next[depart][arrivee] contient le point qui suit le départ sur un plus court chemin vers l'arrivée,
+ * ou NO_NEXT_HOP si le départ et l'arrivée sont confondus ou si l'arrivée est inaccessible.
+ */
+struct NextHopTable
+{
+    uint8_t next[SIZE][SIZE]; // Prochain point à visiter pour chaque paire (départ, arrivée).
+};
+
+#endif // NEXT_HOP_TABLE_H
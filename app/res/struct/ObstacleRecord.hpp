@@ -0,0 +1,27 @@
+/**
+ * @file ObstacleRecord.h
+ * @brief Définition de la structure ObstacleRecord pour mémoriser un segment bloqué.
+ *
+ * Ce fichier contient la définition de la structure ObstacleRecord, l'entrée de la carte des
+ * obstacles conservée en mémoire externe pour chaque segment de la carte.
+ */
+
+#ifndef OBSTACLE_RECORD_H
+#define OBSTACLE_RECORD_H
+
+#include <stdint.h>
+
+/**
+ * @struct ObstacleRecord
+ * @brief Structure représentant ce que le robot sait d'un obstacle sur un segment.
+ *
+ * Le temps est mesuré en nombre de parcours effectués depuis le formatage de la mémoire.
+ * Un segment dont la confiance est nulle n'est pas bloqué.
+ */
+struct ObstacleRecord
+{
+    uint16_t lastSeenRun; // Numéro du dernier parcours où l'obstacle a été détecté.
+    uint8_t confidence;   // Nombre de détections de l'obstacle (saturé à OBSTACLE_MAX_CONFIDENCE).
+};
+
+#endif // OBSTACLE_RECORD_H
@@ -0,0 +1,27 @@
+/**
+ * @file RoadPlan.h
+ * @brief Définition de la structure RoadPlan pour représenter un parcours encodé par plages.
+ *
+ * Ce fichier contient la définition de la structure RoadPlan, la forme compilée d'un RoadSchema
+ * où les directions identiques consécutives sont regroupées en une seule ligne droite.
+ */
+
+#ifndef ROAD_PLAN_H
+#define ROAD_PLAN_H
+
+#include "res/struct/MotionPrimitive.hpp"
+#include "res/struct/RoadSchema.hpp"
+
+/**
+ * @struct RoadPlan
+ * @brief Structure représentant un parcours sous forme de lignes droites.
+ *
+ * Un virage a lieu à la dernière intersection de chaque primitive, sauf la dernière.
+ */
+struct RoadPlan
+{
+    MotionPrimitive primitives[MAX_ROAD_SIZE]; // Lignes droites du parcours, dans l'ordre.
+    uint8_t size;                              // Nombre de lignes droites du parcours.
+};
+
+#endif // ROAD_PLAN_H
@@ -11,9 +11,10 @@
 #define ROAD_SCHEMA_H
 
 #include "res/enum/Cardinal.hpp"
+#include "res/consts.hpp"
 #include "stdint.h"
 
-const uint8_t MAX_ROAD_SIZE = 28; // Taille maximale du parcours en nombre de directions.
+const uint8_t MAX_ROAD_SIZE = SIZE - 1; // Taille maximale du parcours en nombre de directions (chemin sans retour sur un point).
 
 /**
  * @struct RoadSchema
@@ -0,0 +1,40 @@
+/**
+ * @file SelectionTransition.h
+ * @brief Définition de la structure SelectionTransition, ligne de la table de sélection de destination.
+ *
+ * La saisie du point de destination est décrite par une table de transitions (voir RobotManager):
+ * chaque ligne associe un état et un appui de bouton à l'état suivant et à l'action à exécuter.
+ */
+
+#ifndef SELECTION_TRANSITION_H
+#define SELECTION_TRANSITION_H
+
+#include "res/enum/PathConfigState.hpp"
+#include "res/enum/InputEvent.hpp"
+
+class RobotManager;
+class Robot;
+
+// Condition d'une transition, évaluée sur l'état de RobotManager.
+using SelectionGuard = bool (*)(const RobotManager &manager);
+// Action d'une transition, exécutée après le changement d'état.
+using SelectionAction = void (*)(RobotManager &manager, Robot *robot, const volatile PathConfigState &pathConfigState);
+
+/**
+ * @struct SelectionTransition
+ * @brief Transition de la machine à états de sélection du point de destination.
+ *
+ * Une transition définie sur un état composite s'applique à tous ses sous-états qui ne la
+ * redéfinissent pas. Les lignes sont parcourues dans l'ordre: la première dont la condition est
+ * vraie est retenue.
+ */
+struct SelectionTransition
+{
+    PathConfigState state;     // État (simple ou composite) auquel la transition s'applique.
+    InputEvent event;          // Appui de bouton qui déclenche la transition.
+    SelectionGuard guard;      // Condition de la transition (nullptr: toujours vraie).
+    PathConfigState nextState; // État atteint.
+    SelectionAction action;    // Action exécutée dans l'état atteint (nullptr: aucune).
+};
+
+#endif // SELECTION_TRANSITION_H
@@ -27,4 +27,10 @@ bool Button::isPressed()
     return signalIsHigh && signalIsStable;
 }
 
+bool Button::isDown() const
+{
+    bool isHigh = (*pin_ & (1 << pinButton_)) != 0;
+    return (buttonMode_ == ButtonMode::PULL_DOWN) ? isHigh : !isHigh;
+}
+
 Button::~Button() = default;
\ No newline at end of file
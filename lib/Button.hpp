@@ -57,6 +57,15 @@ public:
      */
     bool isPressed();
 
+    /**
+     * @brief Lit l'état instantané du bouton, sans anti-rebond ni attente.
+     *
+     * Destinée à un échantillonnage périodique (voir ButtonDebouncer), y compris depuis une interruption.
+     *
+     * @return true si le bouton est lu appuyé, false sinon.
+     */
+    bool isDown() const;
+
 private:
     Register pin_;                              // PIN permet de lire la valeur du bouton (0 ou 1).
     ButtonMode buttonMode_;                     // Mode du bouton (Actif haut/Actif bas).
@@ -0,0 +1,77 @@
+/**
+ * @file ButtonDebouncer.cpp
+ * @brief Implémentation de la classe ButtonDebouncer.
+ */
+#include "ButtonDebouncer.hpp"
+
+ButtonDebouncer::ButtonDebouncer(EventQueue *events) : buttons_{}, nButtons_(0), events_(events)
+{
+}
+
+bool ButtonDebouncer::addButton(const Button *button, uint8_t firstEvent)
+{
+    uint8_t index = nButtons_;
+    if (index >= BUTTON_DEBOUNCER_MAX_BUTTONS)
+        return false;
+    DebouncedButton &debounced = buttons_[index];
+    debounced.button = button;
+    debounced.firstEvent = firstEvent;
+    debounced.integrator = 0;
+    debounced.isDown = false;
+    debounced.isLongPressed = false;
+    debounced.heldPeriods = 0;
+    // le bouton n'est echantillonne qu'une fois entierement initialise
+    nButtons_ = index + 1;
+    return true;
+}
+
+void ButtonDebouncer::update()
+{
+    uint8_t nButtons = nButtons_;
+    for (uint8_t i = 0; i < nButtons; i++)
+    {
+        DebouncedButton &debounced = buttons_[i];
+        if (debounced.button->isDown())
+        {
+            if (debounced.integrator < BUTTON_DEBOUNCE_PERIODS)
+                debounced.integrator++;
+        }
+        else if (debounced.integrator > 0)
+            debounced.integrator--;
+
+        if (!debounced.isDown)
+        {
+            if (debounced.integrator == BUTTON_DEBOUNCE_PERIODS)
+            {
+                debounced.isDown = true;
+                debounced.isLongPressed = false;
+                debounced.heldPeriods = 0;
+                emit(debounced, ButtonEvent::PRESSED);
+            }
+        }
+        else if (debounced.integrator == 0)
+            debounced.isDown = false;
+        else if (++debounced.heldPeriods >= BUTTON_LONG_PRESS_PERIODS)
+        {
+            emit(debounced, debounced.isLongPressed ? ButtonEvent::REPEATED : ButtonEvent::LONG_PRESSED);
+            debounced.isLongPressed = true;
+            // la prochaine repetition arrive BUTTON_REPEAT_PERIODS plus tard
+            debounced.heldPeriods = BUTTON_LONG_PRESS_PERIODS - BUTTON_REPEAT_PERIODS;
+        }
+    }
+}
+
+bool ButtonDebouncer::isReleased() const
+{
+    for (uint8_t i = 0; i < nButtons_; i++)
+    {
+        if (buttons_[i].isDown || buttons_[i].integrator != 0)
+            return false;
+    }
+    return true;
+}
+
+void ButtonDebouncer::emit(const DebouncedButton &button, ButtonEvent event)
+{
+    events_->push(button.firstEvent + static_cast<uint8_t>(event));
+}
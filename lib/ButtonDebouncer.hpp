@@ -0,0 +1,79 @@
+/**
+ * @file ButtonDebouncer.hpp
+ * @brief Définition de la classe ButtonDebouncer, anti-rebond périodique des boutons.
+ *
+ * Les boutons sont échantillonnés à chaque période de commande par l'interruption du timer 0, sans
+ * attente active. Chaque bouton émet dans une EventQueue ses appuis, ses appuis longs et, tant qu'il
+ * reste maintenu, des répétitions automatiques (voir ButtonEvent).
+ *
+ * @note update() doit être appelée à chaque période de commande, depuis l'interruption du timer 0.
+ */
+#ifndef BUTTON_DEBOUNCER_H
+#define BUTTON_DEBOUNCER_H
+
+#include <stdint.h>
+#include "Button.hpp"
+#include "EventQueue.hpp"
+#include "interfaces/emun/ButtonEvent.hpp"
+#include "interfaces/struct/DebouncedButton.hpp"
+#include "interfaces/consts_lib.hpp"
+
+/**
+ * @class ButtonDebouncer
+ * @brief Anti-rebond par intégrateur et détection des appuis longs de plusieurs boutons.
+ *
+ * L'intégrateur de chaque bouton monte d'un pas par échantillon appuyé et descend d'un pas par
+ * échantillon relâché; l'état ne change qu'aux bornes, ce qui filtre les rebonds sans retarder
+ * la lecture des autres boutons.
+ */
+class ButtonDebouncer
+{
+public:
+    /**
+     * @brief Constructeur de ButtonDebouncer.
+     * @param events La file où sont déposés les événements des boutons.
+     */
+    ButtonDebouncer(EventQueue *events);
+
+    /**
+     * @brief Destructeur par défaut de ButtonDebouncer.
+     */
+    ~ButtonDebouncer() = default;
+
+    /**
+     * @brief Ajoute un bouton à échantillonner.
+     *
+     * Le bouton dépose le code firstEvent + ButtonEvent::PRESSED pour un appui, firstEvent +
+     * ButtonEvent::LONG_PRESSED pour un appui long, etc.
+     *
+     * @param button Le bouton.
+     * @param firstEvent Le code de son premier événement.
+     * @return true si le bouton a été ajouté, false si BUTTON_DEBOUNCER_MAX_BUTTONS est atteint.
+     */
+    bool addButton(const Button *button, uint8_t firstEvent);
+
+    /**
+     * @brief Échantillonne les boutons et dépose leurs événements (appelé à chaque période de commande).
+     */
+    void update();
+
+    /**
+     * @brief Indique si tous les boutons sont relâchés et stables (aucun appui en cours de détection).
+     * @return true si aucun bouton n'est appuyé, même partiellement.
+     */
+    bool isReleased() const;
+
+private:
+    /**
+     * @brief Dépose un événement d'un bouton dans la file.
+     * @param button Le bouton.
+     * @param event L'événement.
+     */
+    void emit(const DebouncedButton &button, ButtonEvent event);
+
+    DebouncedButton buttons_[BUTTON_DEBOUNCER_MAX_BUTTONS]; // Boutons échantillonnés.
+    volatile uint8_t nButtons_;                             // Nombre de boutons échantillonnés.
+    EventQueue *events_;                                    // File des événements des boutons.
+};
+
+#endif // BUTTON_DEBOUNCER_H
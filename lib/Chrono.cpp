@@ -3,7 +3,7 @@
  *
  * @brief Implémentation de la classe Chrono définie dans "Chrono.hpp".
  *
- * La classe Chrono fournit un chronomètre basé sur une instance de Timer.
+ * La classe Chrono fournit un chronomètre basé sur une minuterie de TimerWheel.
  * Ce fichier contient le code pour les méthodes qui contrôlent ce chronomètre,
  * notamment les fonctions pour le démarrer et l'arrêter.
  *
@@ -11,50 +11,31 @@
  * @version 1.0
  * @date [Date de création ou de modification]
  *
- * @note il faut implementer la routine d'interruption dans le main elle incrementera nCyclePassed et
- * verifier si le chrono a expiré et execute les instructions a faire
+ * @note l'echeance est signalee par la fonction passee au constructeur, appelee depuis
+ * l'interruption de la roue des minuteries
  */
 #include "Chrono.hpp"
 
-Chrono::Chrono() : timer_(TimerMode::CTC, Prescaler::PRESCALER_1024), nCyclesPassed(0) {}
-
-void Chrono::start(double durationS)
+Chrono::Chrono(TimerWheel *timerWheel, const MonotonicClock *clock, TimerCallback onExpired, void *context)
+    : timerWheel_(timerWheel), clock_(clock), startUs_(0)
 {
-    nCyclesNeeded = static_cast<uint16_t>(durationS / DELAY_INTERRUPT_S);
-    timer_.setOCRnXRegister(DELAY_INTERRUPT_S, &OCR1A);
-    timer_.enable();
+    timer_ = timerWheel_->create(onExpired, context);
 }
 
-void Chrono::incrementCycles()
+void Chrono::start(const WheelTicks &duration)
 {
-    nCyclesPassed++;
+    startUs_ = clock_->getMicroseconds();
+    timerWheel_->start(timer_, duration);
 }
 
-bool Chrono::isTimerExpired()
+void Chrono::stop()
 {
-    if (nCyclesNeeded > 0)
-    {
-        incrementCycles();
-        if (nCyclesPassed >= nCyclesNeeded)
-        {
-            reset(); // Réinitialiser le compteur après l'expiration
-            return true;
-        }
-        else
-            return false;
-    }
-    return false;
+    timerWheel_->stop(timer_);
 }
 
-void Chrono::reset()
+uint16_t Chrono::getElapsedMs()
 {
-    nCyclesNeeded = 0;
-    nCyclesPassed = 0;
+    if (!timerWheel_->isActive(timer_))
+        return 0;
+    return static_cast<uint16_t>((clock_->getMicroseconds() - startUs_) / 1000);
 }
-
-void Chrono::stop()
-{
-    nCyclesNeeded = 0;
-    nCyclesPassed = 0;
-    timer_.disable();
-}
\ No newline at end of file
@@ -2,8 +2,8 @@
  *  @file Chrono.hpp
  *  @brief Ce fichier contient la déclaration de la classe Chrono
  *
- * La classe Chrono est une abstraction représentant un chronomètre qui utilise une instance du
- * Timer (comme défini dans "Timer.hpp") pour suivre le temps. Elle offre des fonctions pour démarrer et
+ * La classe Chrono est une abstraction représentant un chronomètre qui utilise une minuterie de la
+ * roue TimerWheel et l'horloge MonotonicClock pour suivre le temps. Elle offre des fonctions pour démarrer et
  * arrêter le chronomètre. Le chronomètre est conçu pour être simple à utiliser, tout en offrant la précision et la fiabilité
  * requises pour les tâches de mesure du temps dans divers contextes.
  *
@@ -17,58 +17,59 @@
  */
 #ifndef CHRONO_H
 #define CHRONO_H
-#include "Timer.hpp"
-#include "avr/interrupt.h"
+#include "TimerWheel.hpp"
+#include "MonotonicClock.hpp"
 
 /**
  * @class Chrono
  *
- * Cette classe représente un chronomètre simple. Elle offre la possibilité de démarrer et
- * d'arrêter un chronomètre basé sur un timer. L'utilisation précise du timer n'est pas immédiatement
- * évidente sans accéder à l'implémentation ou à la documentation du Timer.
+ * Cette classe représente un chronomètre simple: une échéance, portée par une minuterie de la roue
+ * (TimerWheel), et le temps écoulé depuis le démarrage, lu sur l'horloge monotone. Plusieurs
+ * chronomètres peuvent coexister sur la même roue.
  */
-
 class Chrono
 {
 public:
     /**
-     * @brief Constructeur par défaut.
-     * Initialise les membres internes de la classe, probablement en mettant le timer en état d'initialisation.
+     * @brief Constructeur de Chrono.
+     * @param timerWheel La roue qui porte l'échéance du chronomètre.
+     * @param clock L'horloge qui mesure le temps écoulé.
+     * @param onExpired Fonction appelée à l'échéance, depuis l'interruption de la roue.
+     * @param context Paramètre passé à la fonction.
      */
-    Chrono();
+    Chrono(TimerWheel *timerWheel, const MonotonicClock *clock, TimerCallback onExpired, void *context);
+
     /**
      * @brief Démarre le chronomètre.
      *
-     * @param durationS Durée en secondes après laquelle le timer doit se terminer ou déclencher une action.
-     */
-    void start(double durationS);
-
-    /**
-     * @brief incremente nCyclesPassed.
+     * Une durée en Milliseconds ou en Seconds est convertie en ticks de la roue, à la compilation si
+     * elle est constante. Un nombre sans unité est refusé. Un chronomètre déjà démarré repart de
+     * zéro avec la nouvelle échéance.
      *
+     * @param duration Durée après laquelle le timer doit se terminer ou déclencher une action.
      */
-    void incrementCycles();
+    void start(const WheelTicks &duration);
 
     /**
-     * @brief renvoie true lorsque le temps inmarti est arrivé.
+     * @brief Retourne le temps écoulé depuis le démarrage du chronomètre.
+     *
+     * La résolution est celle de l'horloge monotone (une microseconde). La valeur revient à zéro
+     * lorsque le chronomètre expire ou est arrêté.
      *
+     * @return uint16_t Le temps écoulé en millisecondes.
      */
-    bool isTimerExpired();
-
-    void reset();
+    uint16_t getElapsedMs();
 
     /**
-     * @brief Arrête le chronomètre.
-     * Cela pourrait interrompre le timer en cours ou simplement marquer la fin du décompte.
+     * @brief Arrête le chronomètre: l'échéance en cours est annulée et ne sera pas signalée.
      */
     void stop();
 
 private:
-    // Un membre privé de type Timer. La valeur template '1' pourrait représenter une spécification particulière pour le Timer 2
-    Timer<1> timer_;
-    const double DELAY_INTERRUPT_S = 0.025;
-    uint16_t nCyclesPassed; // nombre de cycle deja ecouler depuis le debut de compte du timer
-    uint16_t nCyclesNeeded; // nombre de cycle dont on a besoin
+    TimerWheel *timerWheel_;      // Roue qui porte l'échéance.
+    const MonotonicClock *clock_; // Horloge du temps écoulé.
+    uint8_t timer_;               // Minuterie de l'échéance dans la roue.
+    uint32_t startUs_;            // Instant du démarrage, en microsecondes de l'horloge.
 };
 
 #endif // CHRONO_H
@@ -0,0 +1,63 @@
+/**
+ * @file ControlLoop.cpp
+ * @brief Implémentation de la classe ControlLoop.
+ *
+ * Le compteur de périodes est partagé avec l'interruption du timer: sa remise à zéro se fait dans
+ * un bloc atomique.
+ */
+#include "ControlLoop.hpp"
+#include <util/atomic.h>
+
+ControlLoop::ControlLoop() : nTimerTicks_(0), nPendingPeriods_(0), periodCount_(0), tickCount_(0), nOverruns_(0)
+{
+}
+
+bool ControlLoop::tick()
+{
+    tickCount_++;
+    if (++nTimerTicks_ < CONTROL_LOOP_TICK_DIVIDER)
+        return false;
+    nTimerTicks_ = 0;
+    periodCount_++;
+    if (nPendingPeriods_ != UINT8_MAX)
+        nPendingPeriods_++;
+    return true;
+}
+
+bool ControlLoop::waitForNextPeriod()
+{
+    while (nPendingPeriods_ == 0)
+    {
+    }
+    uint8_t nPeriods;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        nPeriods = nPendingPeriods_;
+        nPendingPeriods_ = 0;
+    }
+    if (nPeriods == 1)
+        return true;
+    nOverruns_ += nPeriods - 1;
+    return false;
+}
+
+uint8_t ControlLoop::getPeriodCount() const
+{
+    return periodCount_;
+}
+
+uint16_t ControlLoop::getTickCount() const
+{
+    uint16_t tickCount;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        tickCount = tickCount_;
+    }
+    return tickCount;
+}
+
+uint16_t ControlLoop::getOverruns() const
+{
+    return nOverruns_;
+}
+
@@ -0,0 +1,105 @@
+/**
+ * @file ControlLoop.hpp
+ * @brief Définition de la classe ControlLoop, cadenceur de la boucle de commande.
+ *
+ * La boucle de commande (lecture des capteurs, calcul de la commande, application aux roues) est
+ * cadencée par le débordement du timer 0, qui génère aussi le PWM des roues. Sa fréquence ne dépend
+ * donc plus du temps pris par le reste du code (lectures ADC, écritures LCD, interruptions).
+ *
+ * Description Materielle:
+ * - le timer 0 est en PWM phase correcte avec un prescaler de 8: il déborde à
+ *   CONTROL_TICK_FREQUENCY_HZ. Une période de commande dure CONTROL_LOOP_TICK_DIVIDER débordements.
+ *
+ * @note La routine d'interruption TIMER0_OVF_vect doit être implémentée dans l'application et
+ * appeler tick().
+ */
+#ifndef CONTROL_LOOP_H
+#define CONTROL_LOOP_H
+
+#include <stdint.h>
+#include "Timer.hpp"
+#include "interfaces/struct/Duration.hpp"
+#include "interfaces/consts_lib.hpp"
+
+// Fréquence de débordement du timer 0 (PWM phase correcte: 510 pas par cycle, prescaler de 8).
+constexpr uint16_t CONTROL_TICK_FREQUENCY_HZ = FREQUENCY / (8UL * 510);
+// Débordements du timer par période de commande (fréquence réelle: CONTROL_TICK_FREQUENCY_HZ / diviseur).
+constexpr uint8_t CONTROL_LOOP_TICK_DIVIDER = (CONTROL_TICK_FREQUENCY_HZ + CONTROL_LOOP_FREQUENCY_HZ / 2) / CONTROL_LOOP_FREQUENCY_HZ;
+static_assert(CONTROL_LOOP_TICK_DIVIDER >= 1, "CONTROL_LOOP_FREQUENCY_HZ depasse la frequence du timer 0");
+// Période de débordement du timer 0, en microsecondes.
+constexpr uint32_t CONTROL_TICK_PERIOD_US = 8UL * 510 * 1000000 / FREQUENCY;
+
+// Durée en débordements du timer 0 (horloge de l'ordonnanceur).
+using ControlTicks = Ticks<CONTROL_TICK_PERIOD_US>;
+// Durée en périodes de commande.
+using ControlPeriods = Ticks<CONTROL_TICK_PERIOD_US * CONTROL_LOOP_TICK_DIVIDER>;
+
+/**
+ * @class ControlLoop
+ * @brief Cadence une boucle de commande à fréquence fixe.
+ *
+ * L'interruption du timer compte les périodes écoulées; la boucle appelle waitForNextPeriod au
+ * début de chaque itération. Une itération trop longue n'accumule pas de retard: les périodes
+ * manquées sont comptées comme dépassements puis abandonnées.
+ */
+class ControlLoop
+{
+public:
+    /**
+     * @brief Constructeur de ControlLoop.
+     */
+    ControlLoop();
+
+    /**
+     * @brief Destructeur par défaut de ControlLoop.
+     */
+    ~ControlLoop() = default;
+
+    /**
+     * @brief Compte un débordement du timer. À appeler depuis l'interruption TIMER0_OVF_vect.
+     * @return bool Vrai si ce débordement commence une nouvelle période de commande.
+     */
+    bool tick();
+
+    /**
+     * @brief Attend le début de la prochaine période de commande.
+     * @return true si la période précédente a été respectée, false si au moins une période a été
+     *         manquée.
+     */
+    bool waitForNextPeriod();
+
+    /**
+     * @brief Retourne le numéro de la période de commande en cours.
+     *
+     * Le numéro augmente de un à chaque période (modulo 256); deux lectures qui retournent le même
+     * numéro ont eu lieu pendant la même période.
+     *
+     * @return uint8_t Le numéro de la période.
+     */
+    uint8_t getPeriodCount() const;
+
+    /**
+     * @brief Retourne le nombre de débordements du timer depuis le démarrage.
+     *
+     * Sert d'horodatage à la résolution d'un débordement (1 / CONTROL_TICK_FREQUENCY_HZ); le
+     * compteur revient à zéro après 65536 débordements.
+     *
+     * @return uint16_t Le nombre de débordements.
+     */
+    uint16_t getTickCount() const;
+
+    /**
+     * @brief Retourne le nombre de périodes manquées depuis le démarrage.
+     * @return uint16_t Le nombre de dépassements.
+     */
+    uint16_t getOverruns() const;
+
+private:
+    volatile uint8_t nTimerTicks_;     // Débordements du timer depuis le début de la période.
+    volatile uint8_t nPendingPeriods_; // Périodes commencées et pas encore traitées par la boucle.
+    volatile uint8_t periodCount_;     // Numéro de la période en cours.
+    volatile uint16_t tickCount_;      // Débordements du timer depuis le démarrage.
+    uint16_t nOverruns_;               // Périodes manquées par la boucle.
+};
+
+#endif // CONTROL_LOOP_H
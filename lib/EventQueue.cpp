@@ -0,0 +1,50 @@
+/**
+ * @file EventQueue.cpp
+ * @brief Implémentation de la classe EventQueue.
+ */
+#include "EventQueue.hpp"
+
+EventQueue::EventQueue() : events_{}, head_(0), tail_(0), nLostEvents_(0)
+{
+}
+
+bool EventQueue::push(uint8_t event)
+{
+    uint8_t head = head_;
+    uint8_t nextHead = (head + 1) & (EVENT_QUEUE_SIZE - 1);
+    if (nextHead == tail_)
+    {
+        if (nLostEvents_ != UINT8_MAX)
+            nLostEvents_++;
+        return false;
+    }
+    // l'evenement est ecrit avant de publier le nouvel indice
+    events_[head] = event;
+    head_ = nextHead;
+    return true;
+}
+
+bool EventQueue::pop(uint8_t &event)
+{
+    uint8_t tail = tail_;
+    if (tail == head_)
+        return false;
+    event = events_[tail];
+    tail_ = (tail + 1) & (EVENT_QUEUE_SIZE - 1);
+    return true;
+}
+
+bool EventQueue::isEmpty() const
+{
+    return tail_ == head_;
+}
+
+void EventQueue::clear()
+{
+    tail_ = head_;
+}
+
+uint8_t EventQueue::getLostEvents() const
+{
+    return nLostEvents_;
+}
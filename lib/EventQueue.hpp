@@ -0,0 +1,75 @@
+/**
+ * @file EventQueue.hpp
+ * @brief Définition de la classe EventQueue, file d'événements des interruptions vers la boucle principale.
+ *
+ * Une routine d'interruption ne fait que déposer un code d'événement dans la file, en quelques cycles;
+ * le traitement (écran, sons, machine à états) est fait ensuite par la boucle principale. La durée
+ * des interruptions reste ainsi bornée, quelle que soit la longueur du traitement.
+ */
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <stdint.h>
+#include "interfaces/consts_lib.hpp"
+
+/**
+ * @class EventQueue
+ * @brief File circulaire sans verrou à un seul producteur et un seul consommateur.
+ *
+ * Le producteur (une interruption, ou plusieurs interruptions qui ne s'imbriquent pas) n'écrit que
+ * l'indice d'écriture; le consommateur (la boucle principale) n'écrit que l'indice de lecture. Les
+ * indices tiennent sur un octet: leur lecture est atomique et aucune section critique n'est
+ * nécessaire. La file contient au plus EVENT_QUEUE_SIZE - 1 événements.
+ */
+class EventQueue
+{
+public:
+    /**
+     * @brief Constructeur de EventQueue: la file est vide.
+     */
+    EventQueue();
+
+    /**
+     * @brief Destructeur par défaut de EventQueue.
+     */
+    ~EventQueue() = default;
+
+    /**
+     * @brief Dépose un événement (appelé par le producteur, en général une interruption).
+     * @param event Le code de l'événement.
+     * @return true si l'événement a été déposé, false si la file était pleine (il est perdu).
+     */
+    bool push(uint8_t event);
+
+    /**
+     * @brief Retire le plus ancien événement (appelé par la boucle principale).
+     * @param event Reçoit le code de l'événement.
+     * @return true si un événement a été retiré, false si la file est vide.
+     */
+    bool pop(uint8_t &event);
+
+    /**
+     * @brief Indique si la file est vide.
+     * @return true si aucun événement n'est en attente.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Abandonne les événements en attente (appelé par la boucle principale).
+     */
+    void clear();
+
+    /**
+     * @brief Obtient le nombre d'événements perdus parce que la file était pleine (sature à 255).
+     * @return uint8_t Le nombre d'événements perdus.
+     */
+    uint8_t getLostEvents() const;
+
+private:
+    volatile uint8_t events_[EVENT_QUEUE_SIZE]; // Codes des événements en attente.
+    volatile uint8_t head_;                     // Indice d'écriture (producteur).
+    volatile uint8_t tail_;                     // Indice de lecture (consommateur).
+    volatile uint8_t nLostEvents_;              // Événements perdus parce que la file était pleine.
+};
+
+#endif // EVENT_QUEUE_H
@@ -0,0 +1,98 @@
+/**
+ * @file LinePositionFilter.cpp
+ * @brief Implémentation de la classe LinePositionFilter.
+ *
+ * La fenêtre de vote est un tampon circulaire des derniers échantillons; tant qu'elle n'est pas
+ * remplie, ses cases valent UNDEFINED et ne votent pour aucune position.
+ */
+#include "LinePositionFilter.hpp"
+
+static bool isCross(const LinePosition &position)
+{
+    return position == LinePosition::CROSS_DETECTED || position == LinePosition::CROSS_LEFT_DETECTED ||
+           position == LinePosition::CROSS_RIGHT_DETECTED;
+}
+
+// Deux positions de la meme categorie: identiques, ou deux croisements
+static bool isSameCategory(const LinePosition &first, const LinePosition &second)
+{
+    return first == second || (isCross(first) && isCross(second));
+}
+
+// Fusionne deux croisements vus pendant le meme passage (gauche puis droite donne un croisement complet)
+static LinePosition mergeCross(const LinePosition &first, const LinePosition &second)
+{
+    if (!isCross(first) || first == second)
+        return second;
+    return LinePosition::CROSS_DETECTED;
+}
+
+LinePositionFilter::LinePositionFilter(uint8_t nVotes, uint8_t windowSize, uint8_t minDwell)
+    : nVotes_(nVotes), windowSize_(windowSize > LINE_FILTER_MAX_WINDOW ? LINE_FILTER_MAX_WINDOW : windowSize),
+      minDwell_(minDwell), windowIndex_(0), candidate_(LinePosition::UNDEFINED), candidateDwell_(0),
+      position_(LinePosition::UNDEFINED), intersection_(LinePosition::UNDEFINED)
+{
+    for (uint8_t i = 0; i < LINE_FILTER_MAX_WINDOW; ++i)
+        window_[i] = LinePosition::UNDEFINED;
+}
+
+LinePosition LinePositionFilter::update(const LinePosition &position)
+{
+    window_[windowIndex_] = position;
+    windowIndex_ = (windowIndex_ + 1 == windowSize_) ? 0 : windowIndex_ + 1;
+
+    // un echantillon isole ne gagne pas le vote et ne change rien
+    if (position == LinePosition::UNDEFINED || countVotes(position) < nVotes_)
+        return position_;
+
+    if (candidateDwell_ != 0 && isSameCategory(candidate_, position))
+    {
+        candidate_ = mergeCross(candidate_, position);
+        if (candidateDwell_ != UINT8_MAX)
+            candidateDwell_++;
+    }
+    else
+    {
+        candidate_ = position;
+        candidateDwell_ = 1;
+    }
+
+    if (candidateDwell_ >= minDwell_)
+    {
+        // une intersection par croisement: seulement a l'entree dans le croisement
+        if (isCross(candidate_) && !isCross(position_))
+            intersection_ = candidate_;
+        else if (isCross(candidate_) && isCross(intersection_))
+            intersection_ = mergeCross(intersection_, candidate_);
+        position_ = candidate_;
+    }
+    return position_;
+}
+
+LinePosition LinePositionFilter::getPosition() const
+{
+    return position_;
+}
+
+LinePosition LinePositionFilter::takeIntersection()
+{
+    LinePosition intersection = intersection_;
+    intersection_ = LinePosition::UNDEFINED;
+    return intersection;
+}
+
+void LinePositionFilter::clearIntersection()
+{
+    intersection_ = LinePosition::UNDEFINED;
+}
+
+uint8_t LinePositionFilter::countVotes(const LinePosition &position) const
+{
+    uint8_t nVotes = 0;
+    for (uint8_t i = 0; i < windowSize_; ++i)
+    {
+        if (isSameCategory(window_[i], position))
+            nVotes++;
+    }
+    return nVotes;
+}
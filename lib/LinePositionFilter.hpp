@@ -0,0 +1,88 @@
+/**
+ * @file LinePositionFilter.hpp
+ * @brief Définition de la classe LinePositionFilter, filtre temporel des positions de la ligne.
+ *
+ * Un échantillon bruité des capteurs suffit à produire un faux croisement. Le filtre ne retient une
+ * nouvelle position que si elle gagne un vote sur les derniers échantillons et qu'elle s'y maintient
+ * pendant une durée minimale.
+ */
+#ifndef LINE_POSITION_FILTER_H
+#define LINE_POSITION_FILTER_H
+
+#include <stdint.h>
+#include "interfaces/emun/LinePosition.hpp"
+#include "interfaces/consts_lib.hpp"
+
+/**
+ * @class LinePositionFilter
+ * @brief Filtre à vote majoritaire et temps de maintien minimal des positions de la ligne.
+ *
+ * Une position est candidate lorsqu'elle est présente dans au moins nVotes des windowSize derniers
+ * échantillons; elle devient la position filtrée lorsqu'elle gagne minDwell votes de suite, sans
+ * qu'une autre position ne gagne entre-temps. Les trois types de croisement sont votés ensemble: un croisement abordé
+ * en biais (gauche puis complet) ne partage pas ses votes et son type est la fusion des types vus.
+ *
+ * Un événement d'intersection est émis une seule fois par croisement physique: au passage de la
+ * position filtrée d'une position de suivi à un croisement.
+ */
+class LinePositionFilter
+{
+public:
+    /**
+     * @brief Constructeur de LinePositionFilter.
+     * @param nVotes Nombre minimal d'échantillons de la fenêtre en faveur d'une position.
+     * @param windowSize Nombre d'échantillons de la fenêtre de vote (au plus LINE_FILTER_MAX_WINDOW).
+     * @param minDwell Nombre de votes successifs qu'une position candidate doit gagner avant d'être
+     *        retenue.
+     */
+    LinePositionFilter(uint8_t nVotes, uint8_t windowSize, uint8_t minDwell);
+
+    /**
+     * @brief Destructeur par défaut de LinePositionFilter.
+     */
+    ~LinePositionFilter() = default;
+
+    /**
+     * @brief Ajoute un échantillon au filtre.
+     * @param position La position de la ligne classée à partir des capteurs.
+     * @return LinePosition La position filtrée.
+     */
+    LinePosition update(const LinePosition &position);
+
+    /**
+     * @brief Retourne la position filtrée, UNDEFINED tant qu'aucune position n'a été retenue.
+     * @return LinePosition La position filtrée.
+     */
+    LinePosition getPosition() const;
+
+    /**
+     * @brief Retourne et consomme l'intersection franchie depuis le dernier appel.
+     * @return LinePosition Le type du croisement, ou UNDEFINED si aucun croisement n'a été franchi.
+     */
+    LinePosition takeIntersection();
+
+    /**
+     * @brief Abandonne l'intersection en attente sans modifier la position filtrée.
+     */
+    void clearIntersection();
+
+private:
+    /**
+     * @brief Compte les échantillons de la fenêtre de la même catégorie qu'une position.
+     * @param position La position recherchée.
+     * @return uint8_t Le nombre de votes.
+     */
+    uint8_t countVotes(const LinePosition &position) const;
+
+    uint8_t nVotes_;                           // Votes nécessaires pour qu'une position soit candidate.
+    uint8_t windowSize_;                       // Taille de la fenêtre de vote.
+    uint8_t minDwell_;                         // Échantillons de maintien avant de retenir une position.
+    LinePosition window_[LINE_FILTER_MAX_WINDOW]; // Derniers échantillons (tampon circulaire).
+    uint8_t windowIndex_;                      // Indice du prochain échantillon de la fenêtre.
+    LinePosition candidate_;                   // Position qui gagne le vote.
+    uint8_t candidateDwell_;                   // Votes successifs gagnés par la position candidate.
+    LinePosition position_;                    // Position filtrée.
+    LinePosition intersection_;                // Croisement franchi pas encore consommé.
+};
+
+#endif // LINE_POSITION_FILTER_H
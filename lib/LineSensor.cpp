@@ -5,23 +5,44 @@
  * Ce fichier implémente les méthodes de la classe LineSensor. Il gère la logique de
  * fonctionnement des capteurs de ligne du robot, permettant de détecter la position de la ligne
  * et d'ajuster le mouvement du robot en conséquence.
+ *
+ * Les cinq capteurs sont sur des broches consécutives de PORTA (PA3 à PA7): un seul accès à PINA
+ * donne un état sur 5 bits. La position de la ligne et son estimation pondérée sont précalculées
+ * pour les LINE_SENSOR_N_STATES états possibles et placées en mémoire flash.
+ *
+ * Les transitions des capteurs sont aussi capturées par l'interruption de changement de broche dans
+ * une file circulaire à un producteur (l'interruption) et un consommateur (la boucle principale).
  */
 #include "LineSensor.hpp"
 #include "Communication.hpp"
+#include <avr/pgmspace.h>
 
-LineSensor::LineSensor()
-{
-    initIO();
-}
+static_assert(DIGITAL_OUTPUT_D2 == DIGITAL_OUTPUT_D1 + 1 && DIGITAL_OUTPUT_D3 == DIGITAL_OUTPUT_D1 + 2 &&
+                  DIGITAL_OUTPUT_D4 == DIGITAL_OUTPUT_D1 + 3 && DIGITAL_OUTPUT_D5 == DIGITAL_OUTPUT_D1 + 4,
+              "les capteurs de ligne doivent etre sur des broches consecutives");
+static_assert((LINE_EVENT_BUFFER_SIZE & (LINE_EVENT_BUFFER_SIZE - 1)) == 0, "LINE_EVENT_BUFFER_SIZE doit etre une puissance de 2");
 
-LinePosition LineSensor::determineLinePosition()
-{
+static const uint8_t SENSORS_MASK = LINE_SENSOR_N_STATES - 1;         // Bits des capteurs après décalage.
+static const uint8_t SENSORS_PIN_MASK = SENSORS_MASK << DIGITAL_OUTPUT_D1; // Bits des capteurs dans PINA.
+
+static const uint8_t SENSOR_S1 = 1 << 0; // Capteur le plus à gauche (S1)
+static const uint8_t SENSOR_S2 = 1 << 1; // Capteur gauche (S2)
+static const uint8_t SENSOR_S3 = 1 << 2; // Capteur central (S3)
+static const uint8_t SENSOR_S4 = 1 << 3; // Capteur droit (S4)
+static const uint8_t SENSOR_S5 = 1 << 4; // Capteur le plus à droite (S5)
 
-    bool leftMost = readLineSensorsState(DIGITAL_OUTPUT_D1);  // Capteur le plus à gauche (S1)
-    bool left = readLineSensorsState(DIGITAL_OUTPUT_D2);      // Capteur gauche (S2)
-    bool center = readLineSensorsState(DIGITAL_OUTPUT_D3);    // Capteur central (S3)
-    bool right = readLineSensorsState(DIGITAL_OUTPUT_D4);     // Capteur droit (S4)
-    bool rightMost = readLineSensorsState(DIGITAL_OUTPUT_D5); // Capteur le plus à droite (S5)
+/**
+ * @brief Classe un état des capteurs en position de ligne.
+ * @param state L'état des capteurs (bit 0 pour S1 jusqu'au bit 4 pour S5).
+ * @return LinePosition La position correspondante.
+ */
+static constexpr LinePosition classifyLinePosition(uint8_t state)
+{
+    bool leftMost = state & SENSOR_S1;
+    bool left = state & SENSOR_S2;
+    bool center = state & SENSOR_S3;
+    bool right = state & SENSOR_S4;
+    bool rightMost = state & SENSOR_S5;
 
     bool cross = leftMost && left && center && right && rightMost; // permet de savoir si un cross
     bool crossLeft = left && center && leftMost && !rightMost;     // permet de savoir si un cross a gauche est detecté
@@ -57,9 +78,169 @@ LinePosition LineSensor::determineLinePosition()
     return LinePosition::UNDEFINED;
 }
 
-bool LineSensor::readLineSensorsState(const uint8_t sensorPin)
+/**
+ * @brief Calcule la moyenne des poids des capteurs actifs d'un état.
+ * @param state L'état des capteurs, avec au moins un capteur actif.
+ * @return int8_t La position estimée, de -LINE_POSITION_MAX à LINE_POSITION_MAX.
+ */
+static constexpr int8_t averageLinePosition(uint8_t state)
 {
-    return (PINA & (1 << sensorPin)) == (1 << sensorPin);
+    int16_t weightSum = 0;
+    uint8_t nActiveSensors = 0;
+    int8_t weight = -LINE_POSITION_MAX;
+    for (uint8_t sensor = SENSOR_S1; sensor <= SENSOR_S5; sensor <<= 1)
+    {
+        if (state & sensor)
+        {
+            weightSum += weight;
+            nActiveSensors++;
+        }
+        weight += LINE_SENSOR_WEIGHT_STEP;
+    }
+    return (nActiveSensors == 0) ? 0 : static_cast<int8_t>(weightSum / nActiveSensors);
+}
+
+/**
+ * @struct LineSensorTable
+ * @brief Décodage précalculé de chaque état des capteurs.
+ */
+struct LineSensorTable
+{
+    LinePosition positions[LINE_SENSOR_N_STATES]; // Position de la ligne pour chaque état.
+    int8_t estimates[LINE_SENSOR_N_STATES];       // Position estimée pour chaque état.
+};
+
+static constexpr LineSensorTable buildLineSensorTable()
+{
+    LineSensorTable table = {};
+    for (uint8_t state = 0; state < LINE_SENSOR_N_STATES; ++state)
+    {
+        table.positions[state] = classifyLinePosition(state);
+        table.estimates[state] = averageLinePosition(state);
+    }
+    return table;
+}
+
+static constexpr LineSensorTable lineSensorTable PROGMEM = buildLineSensorTable();
+
+static LinePosition classifyState(uint8_t state)
+{
+    return static_cast<LinePosition>(pgm_read_byte(&lineSensorTable.positions[state]));
+}
+
+LineSensor::LineSensor(const ControlLoop *controlLoop)
+    : controlLoop_(controlLoop), sensorsState_(0), samplePeriod_(0), isSampleValid_(false),
+      filter_(LINE_FILTER_VOTES, LINE_FILTER_WINDOW, LINE_FILTER_MIN_DWELL_PERIODS), eventHead_(0), eventTail_(0), nLostEvents_(0), replayState_(0), lastReplayTick_(0), lastLinePosition_(0)
+{
+    initIO();
+}
+
+LinePosition LineSensor::determineLinePosition()
+{
+    readLineSensorsState();
+    return filter_.getPosition();
+}
+
+LinePosition LineSensor::takeIntersection()
+{
+    readLineSensorsState();
+    return filter_.takeIntersection();
+}
+
+int8_t LineSensor::estimateLinePosition()
+{
+    uint8_t state = readLineSensorsState();
+
+    // ligne perdue: on la suppose sortie du cote ou elle a ete vue en dernier
+    if (state == 0)
+    {
+        if (lastLinePosition_ < 0)
+            return -LINE_POSITION_MAX;
+        return (lastLinePosition_ > 0) ? LINE_POSITION_MAX : 0;
+    }
+    lastLinePosition_ = static_cast<int8_t>(pgm_read_byte(&lineSensorTable.estimates[state]));
+    return lastLinePosition_;
+}
+
+bool LineSensor::isLineOnCenter()
+{
+    return readLineSensorsState() & SENSOR_S3;
+}
+
+uint8_t LineSensor::readLineSensorsState()
+{
+    uint8_t period = controlLoop_->getPeriodCount();
+    if (!isSampleValid_ || period != samplePeriod_)
+    {
+        // une seule lecture du port: les cinq capteurs sont echantillonnes au meme instant
+        sensorsState_ = (PINA >> DIGITAL_OUTPUT_D1) & SENSORS_MASK;
+        // premiere lecture: le rejeu part de l'etat actuel, sans les transitions anterieures
+        if (!isSampleValid_)
+            clearTransitions();
+        samplePeriod_ = period;
+        isSampleValid_ = true;
+
+        replayTransitions();
+    }
+    return sensorsState_;
+}
+
+void LineSensor::enableTransitionCapture()
+{
+    PCMSK0 |= SENSORS_PIN_MASK;
+    PCIFR = (1 << PCIF0);
+    setRegisterBits(&PCICR, PCIE0);
+}
+
+void LineSensor::captureTransition()
+{
+    uint8_t state = (PINA >> DIGITAL_OUTPUT_D1) & SENSORS_MASK;
+    uint8_t head = eventHead_;
+    uint8_t nextHead = (head + 1) & (LINE_EVENT_BUFFER_SIZE - 1);
+    if (nextHead == eventTail_)
+    {
+        if (nLostEvents_ != UINT8_MAX)
+            nLostEvents_++;
+        return;
+    }
+    events_[head].state = state;
+    events_[head].timestamp = controlLoop_->getTickCount();
+    eventHead_ = nextHead;
+}
+
+void LineSensor::clearTransitions()
+{
+    eventTail_ = eventHead_;
+    replayState_ = sensorsState_;
+    lastReplayTick_ = controlLoop_->getTickCount();
+    filter_.clearIntersection();
+}
+
+void LineSensor::replayTransitions()
+{
+    uint16_t now = controlLoop_->getTickCount();
+    // apres une longue attente, seules les dernieres periodes sont rejouees
+    if (static_cast<uint16_t>(now - lastReplayTick_) > LINE_FILTER_MAX_REPLAY * CONTROL_LOOP_TICK_DIVIDER)
+        lastReplayTick_ = now - LINE_FILTER_MAX_REPLAY * CONTROL_LOOP_TICK_DIVIDER;
+
+    uint8_t tail = eventTail_;
+    uint8_t head = eventHead_;
+    while (static_cast<uint16_t>(now - lastReplayTick_) >= CONTROL_LOOP_TICK_DIVIDER)
+    {
+        lastReplayTick_ += CONTROL_LOOP_TICK_DIVIDER;
+        // etat des capteurs a la fin de cette periode: derniere transition qui la precede
+        while (tail != head && static_cast<int16_t>(events_[tail].timestamp - lastReplayTick_) <= 0)
+        {
+            replayState_ = events_[tail].state;
+            tail = (tail + 1) & (LINE_EVENT_BUFFER_SIZE - 1);
+        }
+        filter_.update(classifyState(replayState_));
+    }
+    eventTail_ = tail;
+
+    // file vide: l'etat rejoue se recale sur la lecture du port (transitions perdues)
+    if (tail == head)
+        replayState_ = sensorsState_;
 }
 
 void LineSensor::initIO()
@@ -69,4 +250,4 @@ void LineSensor::initIO()
     clearRegisterBits(&DDRA, DIGITAL_OUTPUT_D3);
     clearRegisterBits(&DDRA, DIGITAL_OUTPUT_D4);
     clearRegisterBits(&DDRA, DIGITAL_OUTPUT_D5);
-}
\ No newline at end of file
+}
@@ -5,6 +5,14 @@
  * La classe LineSensor fournit des fonctionnalités pour détecter la position d'une ligne
  * sur laquelle le robot est positionné. Elle utilise un capteur de suiveur de ligne pour déterminer
  * la position précise de la ligne par rapport au robot.
+ *
+ * Description Materielle:
+ * - les capteurs (PA3 à PA7) déclenchent l'interruption de changement de broche PCINT0_vect: chaque
+ *   transition est horodatée et mise en file, de sorte qu'une intersection franchie entre deux
+ *   lectures de la boucle principale n'est pas manquée.
+ *
+ * @note La routine d'interruption PCINT0_vect doit être implémentée dans l'application et appeler
+ * captureTransition().
  */
 #ifndef LINE_SENSOR_H
 #define LINE_SENSOR_H
@@ -13,6 +21,9 @@
 #include "interfaces/emun/LinePosition.hpp"
 #include "interfaces/utils.hpp"
 #include "interfaces/consts_lib.hpp"
+#include "interfaces/struct/LineSensorEvent.hpp"
+#include "ControlLoop.hpp"
+#include "LinePositionFilter.hpp"
 
 /**
  * @class LineSensor
@@ -29,21 +40,92 @@ public:
 
 private:
     // Constructeur et destructeur
-    LineSensor();
+    /**
+     * @param controlLoop La boucle de commande dont chaque période donne lieu à une seule lecture
+     *        des capteurs.
+     */
+    LineSensor(const ControlLoop *controlLoop);
     ~LineSensor() = default;
 
     /**
      * @brief Détermine la position de la ligne par rapport au robot.
-     * @return LinePosition Position de la ligne (perdue, gauche, droite, etc.).
+     *
+     * L'état des capteurs est décodé par une table de LINE_SENSOR_N_STATES positions en mémoire
+     * flash, puis filtrée (vote et temps de maintien, voir LinePositionFilter) à raison d'un
+     * échantillon par période de commande, reconstitué à partir des transitions capturées par
+     * interruption.
+     *
+     * @return LinePosition Position filtrée de la ligne (perdue, gauche, droite, etc.).
      */
     LinePosition determineLinePosition();
 
     /**
-     * @brief Lit l'état du capteur de ligne spécifié.
-     * @param sensorPin Le numéro de la broche du capteur à lire.
-     * @return bool Vrai si la ligne est détectée sur la broche spécifiée, faux sinon.
+     * @brief Retourne et consomme l'intersection franchie depuis le dernier appel.
+     *
+     * L'intersection n'est signalée qu'une fois par croisement physique, quel que soit le nombre de
+     * périodes passées sur le croisement.
+     *
+     * @return LinePosition Le type du croisement, ou UNDEFINED si aucun croisement n'a été franchi.
      */
-    bool readLineSensorsState(const uint8_t sensorPin);
+    LinePosition takeIntersection();
+
+    /**
+     * @brief Estime la position de la ligne par la moyenne pondérée des capteurs actifs.
+     *
+     * Chaque capteur a un poids de -LINE_POSITION_MAX (S1, à gauche) à LINE_POSITION_MAX (S5, à
+     * droite). Si aucun capteur ne voit la ligne, la position est saturée du dernier côté où elle
+     * a été vue.
+     *
+     * @return int8_t La position de la ligne: négative à gauche, nulle au centre, positive à droite.
+     */
+    int8_t estimateLinePosition();
+
+    /**
+     * @brief Indique si la ligne est sous le capteur central (S3).
+     * @return bool Vrai si le capteur central détecte la ligne.
+     */
+    bool isLineOnCenter();
+
+    /**
+     * @brief Retourne l'état des cinq capteurs, lu une seule fois par période de commande.
+     *
+     * Les capteurs sont lus ensemble par une seule lecture de PINA; les lectures suivantes de la
+     * même période de la boucle de commande réutilisent cet échantillon.
+     *
+     * @return uint8_t L'état des capteurs: bit 0 pour S1 (à gauche) jusqu'au bit 4 pour S5.
+     */
+    uint8_t readLineSensorsState();
+
+    /**
+     * @brief Active la capture des transitions des capteurs par l'interruption PCINT0_vect.
+     */
+    void enableTransitionCapture();
+
+    /**
+     * @brief Met en file l'état des capteurs après une transition, avec son horodatage.
+     *
+     * Appelée par la routine d'interruption PCINT0_vect. Si la file est pleine, la transition est
+     * perdue et comptée.
+     */
+    void captureTransition();
+
+    /**
+     * @brief Abandonne les transitions en attente et l'intersection de la période en cours.
+     *
+     * À appeler après une manœuvre (rotation sur place) dont les transitions ne doivent pas être
+     * prises pour une intersection.
+     */
+    void clearTransitions();
+
+    /**
+     * @brief Rejoue les transitions en attente pour fournir au filtre un échantillon par période.
+     *
+     * L'état des capteurs à la fin de chaque période écoulée depuis le dernier appel est reconstitué
+     * à partir des transitions horodatées: un croisement franchi pendant que la boucle principale
+     * était occupée est filtré comme s'il avait été lu à chaque période (au plus
+     * LINE_FILTER_MAX_REPLAY périodes).
+     */
+    void replayTransitions();
 
     /**
      * @brief Initialise les entrées/sorties pour les capteurs de ligne.
@@ -51,6 +133,19 @@ private:
      * Configure les broches des capteurs de ligne en tant qu'entrées numériques.
      */
     void initIO();
+
+    const ControlLoop *controlLoop_; // Boucle de commande qui date les échantillons.
+    uint8_t sensorsState_;           // Dernier échantillon des capteurs.
+    uint8_t samplePeriod_;           // Période de commande de l'échantillon.
+    bool isSampleValid_;             // Indique si un échantillon a déjà été lu.
+    LinePositionFilter filter_;      // Filtre des positions rejouées à chaque période.
+    volatile LineSensorEvent events_[LINE_EVENT_BUFFER_SIZE]; // File des transitions (écrite par l'interruption).
+    volatile uint8_t eventHead_;     // Indice d'écriture de la file (interruption).
+    volatile uint8_t eventTail_;     // Indice de lecture de la file (boucle principale).
+    volatile uint8_t nLostEvents_;   // Transitions perdues parce que la file était pleine.
+    uint8_t replayState_;            // État des capteurs à la dernière période rejouée.
+    uint16_t lastReplayTick_;        // Fin de la dernière période rejouée, en débordements du timer 0.
+    int8_t lastLinePosition_;        // Dernière position estimée alors que la ligne était visible.
 };
 
 #endif
\ No newline at end of file
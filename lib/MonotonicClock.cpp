@@ -0,0 +1,44 @@
+/**
+ * @file MonotonicClock.cpp
+ * @brief Implémentation de la classe MonotonicClock.
+ */
+#include "MonotonicClock.hpp"
+#include <util/atomic.h>
+
+MonotonicClock::MonotonicClock() : timer_(TimerMode::NORMAL, Prescaler::PRESCALER_8), nOverflows_(0)
+{
+}
+
+void MonotonicClock::enable()
+{
+    timer_.enable();
+    OCR1A = TCNT1 + TIMER_WHEEL_TICK_US;
+    TIFR1 = (1 << OCF1A);
+    setRegisterBits(&TIMSK1, OCIE1A);
+}
+
+void MonotonicClock::handleOverflow()
+{
+    nOverflows_++;
+}
+
+void MonotonicClock::scheduleNextTick()
+{
+    // la comparaison avance d'une periode sans toucher au compteur: aucune derive
+    OCR1A += TIMER_WHEEL_TICK_US;
+}
+
+uint32_t MonotonicClock::getMicroseconds() const
+{
+    uint16_t high;
+    uint16_t low;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        high = nOverflows_;
+        low = TCNT1;
+        // debordement pas encore traite: le compteur est deja reparti de zero
+        if ((TIFR1 & (1 << TOV1)) && low < 0x8000)
+            high++;
+    }
+    return (static_cast<uint32_t>(high) << 16) | low;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file MonotonicClock.hpp
+ * @brief Définition de la classe MonotonicClock, horloge monotone à la microseconde sur le timer 1.
+ *
+ * Le timer 1 compte librement (mode normal); son débordement incrémente un compteur logiciel qui
+ * forme les 16 bits de poids fort du temps. La comparaison A du même timer, avancée de
+ * TIMER_WHEEL_TICK_US à chaque interruption, cadence la roue des minuteries (TimerWheel) sans
+ * jamais remettre le compteur à zéro.
+ *
+ * Description Materielle:
+ * - timer 1 en mode normal avec un prescaler de 8: un pas par microseconde à 8 MHz, débordement
+ *   toutes les 65,536 ms. Le temps sur 32 bits revient à zéro après 71 minutes.
+ * - le timer 1 est arrêté en veille profonde (POWER_DOWN): le temps ne compte pas pendant la veille.
+ *
+ * @note Les routines d'interruption TIMER1_OVF_vect et TIMER1_COMPA_vect doivent être implémentées
+ * dans l'application et appeler handleOverflow() et scheduleNextTick().
+ */
+#ifndef MONOTONIC_CLOCK_H
+#define MONOTONIC_CLOCK_H
+
+#include <stdint.h>
+#include "Timer.hpp"
+#include "interfaces/consts_lib.hpp"
+
+static_assert(FREQUENCY / 8 == 1000000UL, "le prescaler de 8 du timer 1 doit donner un pas d'une microseconde");
+
+/**
+ * @class MonotonicClock
+ * @brief Temps écoulé depuis le démarrage, en microsecondes, et cadence de la roue des minuteries.
+ */
+class MonotonicClock
+{
+public:
+    /**
+     * @brief Constructeur de MonotonicClock: configure le timer 1 en comptage libre.
+     */
+    MonotonicClock();
+
+    /**
+     * @brief Destructeur par défaut de MonotonicClock.
+     */
+    ~MonotonicClock() = default;
+
+    /**
+     * @brief Active les interruptions de débordement et de comparaison A du timer 1.
+     */
+    void enable();
+
+    /**
+     * @brief Compte un débordement du timer 1 (appelée par l'interruption TIMER1_OVF_vect).
+     */
+    void handleOverflow();
+
+    /**
+     * @brief Programme la prochaine interruption de comparaison (appelée par TIMER1_COMPA_vect).
+     */
+    void scheduleNextTick();
+
+    /**
+     * @brief Obtient le temps écoulé depuis l'activation de l'horloge.
+     *
+     * Un débordement survenu mais pas encore traité (interruptions désactivées) est pris en compte.
+     *
+     * @return uint32_t Le temps en microsecondes.
+     */
+    uint32_t getMicroseconds() const;
+
+private:
+    Timer<1> timer_;                // Timer 1 en comptage libre.
+    volatile uint16_t nOverflows_; // Débordements du timer 1 (poids fort du temps).
+};
+
+#endif // MONOTONIC_CLOCK_H
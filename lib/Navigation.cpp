@@ -15,8 +15,11 @@
  **/
 #include "Navigation.hpp"
 #include "Communication.hpp"
+#include <util/atomic.h>
 
-Navigation::Navigation() : leftWheel_(&timer_, LEFT_WHEEL_DIRECTION, &OCR0B), rightWheel_(&timer_, RIGHT_WHEEL_DIRECTION, &OCR0A)
+Navigation::Navigation() : leftWheel_(&timer_, LEFT_WHEEL_DIRECTION, &OCR0B), rightWheel_(&timer_, RIGHT_WHEEL_DIRECTION, &OCR0A),
+                           timer_(TimerMode::PWM, Prescaler::PRESCALER_8), linearProfile_(LINEAR_MAX_ACCELERATION, LINEAR_MAX_JERK),
+                           angularProfile_(ANGULAR_MAX_ACCELERATION, ANGULAR_MAX_JERK)
 {
     initIO();
 };
@@ -29,75 +32,70 @@ void Navigation::initIO()
     setRegisterBits(&DDRB, RIGHT_WHEEL_ENABLE);
 };
 
-void Navigation::moveForward(const double speedLeft, const double speedRight)
+void Navigation::moveForward(const DutyCycle &speedLeft, const DutyCycle &speedRight)
 {
-    leftWheel_.turnWheelForward(speedLeft);
-    rightWheel_.turnWheelForward(speedRight);
+    setWheelTargets(speedLeft.value, speedRight.value);
 };
 
-void Navigation::moveBackward(const double speedLeft, const double speedRight)
+void Navigation::moveBackward(const DutyCycle &speedLeft, const DutyCycle &speedRight)
 {
-    leftWheel_.turnWheelBackward(speedLeft);
-    rightWheel_.turnWheelBackward(speedRight);
+    setWheelTargets(-static_cast<int16_t>(speedLeft.value), -static_cast<int16_t>(speedRight.value));
 };
 
-void Navigation::turnLeft(const double speedLeft, const double speedRight)
+void Navigation::turnLeft(const DutyCycle &speedLeft, const DutyCycle &speedRight)
 {
-    leftWheel_.turnWheelBackward(speedLeft);
-    rightWheel_.turnWheelForward(speedRight);
+    setWheelTargets(-static_cast<int16_t>(speedLeft.value), speedRight.value);
 };
 
-void Navigation::turnRight(const double speedLeft, const double speedRight)
+void Navigation::turnRight(const DutyCycle &speedLeft, const DutyCycle &speedRight)
 {
-    leftWheel_.turnWheelForward(speedLeft);
-    rightWheel_.turnWheelBackward(speedRight);
+    setWheelTargets(speedLeft.value, -static_cast<int16_t>(speedRight.value));
 };
 
-void Navigation::turn90Degre(const Direction &direction)
+void Navigation::setWheelTargets(int16_t speedLeft, int16_t speedRight)
 {
-
-    if (direction == Direction::LEFT)
+    // avance: moyenne des roues; rotation: demi-ecart (positif vers la droite)
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
     {
-        turnLeft(MAX_SPEED, MAX_SPEED);
-        _delay_ms(DELAY_IMPULSION);
-        turnLeft(SPEED_TO_TURN_BACKWARD + PERCENT_TO_ADJUST_TURN, SPEED_TO_TURN_FORWARD);
+        linearProfile_.setTarget((speedLeft + speedRight) / 2);
+        angularProfile_.setTarget((speedLeft - speedRight) / 2);
     }
-    else if (direction == Direction::RIGHT)
-    {
-        // petite impulsion au roue pour bien demarrer
-        turnRight(MAX_SPEED, MAX_SPEED);
-        _delay_ms(DELAY_IMPULSION);
-        turnRight(SPEED_TO_TURN_FORWARD + PERCENT_TO_ADJUST, SPEED_TO_TURN_BACKWARD + PERCENT_TO_ADJUST_TURN);
-    }
-    _delay_ms(DELAY_TURN_90_DEGRE);
-    stop();
-    //_delay_ms(DELAY_STOP_AFTER_TURN);
 }
-void Navigation::turn180Degre(const Direction &direction)
+
+void Navigation::updateProfile()
+{
+    int16_t linear = linearProfile_.update();
+    int16_t angular = angularProfile_.update();
+    applyWheelSpeed(leftWheel_, linear + angular);
+    applyWheelSpeed(rightWheel_, linear - angular);
+}
+
+void Navigation::applyWheelSpeed(Wheel &wheel, int16_t speed)
+{
+    if (speed < 0)
+        wheel.turnWheelBackward(clampDutyCycle(-speed));
+    else
+        wheel.turnWheelForward(clampDutyCycle(speed));
+}
+
+void Navigation::spin(const Direction &direction)
 {
     if (direction == Direction::LEFT)
-    {
-        turnLeft(MAX_SPEED, MAX_SPEED);
-        _delay_ms(DELAY_IMPULSION);
         turnLeft(SPEED_TO_TURN_BACKWARD + PERCENT_TO_ADJUST_TURN, SPEED_TO_TURN_FORWARD);
-    }
     else if (direction == Direction::RIGHT)
-    {
-        turnRight(MAX_SPEED, MAX_SPEED);
-        _delay_ms(DELAY_IMPULSION);
-        turnRight(SPEED_TO_TURN_FORWARD + +PERCENT_TO_ADJUST, SPEED_TO_TURN_BACKWARD + PERCENT_TO_ADJUST_TURN);
-    }
-    _delay_ms(DELAY_TURN_180_DEGRE);
-    stop();
+        turnRight(SPEED_TO_TURN_FORWARD + PERCENT_TO_ADJUST, SPEED_TO_TURN_BACKWARD + PERCENT_TO_ADJUST_TURN);
 }
 
-void Navigation::turn360Degre()
+void Navigation::arcTurn(const Direction &direction)
 {
-    turn180Degre(Direction::LEFT);
-    turn180Degre(Direction::LEFT);
+    // la roue exterieure va plus vite: le robot tourne en continuant d'avancer
+    if (direction == Direction::LEFT)
+        moveForward(ARC_TURN_INNER_SPEED + PERCENT_TO_ADJUST, ARC_TURN_OUTER_SPEED);
+    else if (direction == Direction::RIGHT)
+        moveForward(ARC_TURN_OUTER_SPEED + PERCENT_TO_ADJUST, ARC_TURN_INNER_SPEED);
 }
 
-void Navigation::moveWheelToDirection(const Direction &direction, const double speedLeft, const double speedRight)
+void Navigation::moveWheelToDirection(const Direction &direction, const DutyCycle &speedLeft, const DutyCycle &speedRight)
 {
     switch (direction)
     {
@@ -116,10 +114,35 @@ void Navigation::moveWheelToDirection(const Direction &direction, const double s
     }
 };
 
+void Navigation::enableControlTick()
+{
+    timer_.enable();
+}
+
 void Navigation::stop()
 {
-    leftWheel_.stop();
-    rightWheel_.stop();
+    setWheelTargets(0, 0);
 };
 
+void Navigation::brake()
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        linearProfile_.reset(0);
+        angularProfile_.reset(0);
+        leftWheel_.stop();
+        rightWheel_.stop();
+    }
+}
+
+bool Navigation::isStopped() const
+{
+    bool isStopped;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        isStopped = linearProfile_.isAtRest() && angularProfile_.isAtRest();
+    }
+    return isStopped;
+}
+
 Navigation::~Navigation() = default;
\ No newline at end of file
@@ -9,6 +9,14 @@
  * Description Materielle:
  * - les broches PB4 et PB6 sont respectivement connectés aux enable et direction de la roue gauche.
  * - les broches PB3 et PB5 sont respectivement connectés aux enable et direction de la roue droite.
+ * - le timer 0 génère le PWM des roues (prescaler de 8) et cadence la boucle de commande.
+ *
+ * Les commandes de mouvement ne changent que les consignes de vitesse: les rapports cycliques des
+ * roues suivent des profils à accélération limitée (voir VelocityProfile), un pour l'avance et un
+ * pour la rotation, avancés par updateProfile à chaque période de commande.
+ *
+ * @note updateProfile doit être appelée par l'application à chaque période de la boucle de
+ * commande (depuis TIMER0_OVF_vect).
  *
  * @author Aymane Bourchirch
  * @author Beaurel Fohom
@@ -23,6 +31,7 @@
 #define NAVIGATION_H
 #include "Wheel.hpp"
 #include "Timer.hpp"
+#include "VelocityProfile.hpp"
 #include "interfaces/emun/Direction.hpp"
 #include "util/delay.h"
 #include "Can.hpp"
@@ -58,32 +67,57 @@ public:
      * @param speedLeft La vitesse à laquelle le roue gauche doit se déplacer.
      * @param speedRight La vitesse à laquelle le roue droite doit se déplacer.
      */
-    void moveWheelToDirection(const Direction &direction, const double speedLeft, const double speedRight);
+    void moveWheelToDirection(const Direction &direction, const DutyCycle &speedLeft, const DutyCycle &speedRight);
+
+    /**
+     * @brief Active l'interruption de débordement du timer des roues (TIMER0_OVF_vect).
+     *
+     * Elle cadence la boucle de commande (voir ControlLoop); la routine d'interruption doit être
+     * implémentée avant l'appel.
+     */
+    void enableControlTick();
 
     /**
-     * @brief Arrête le robot.
+     * @brief Avance les profils de vitesse d'une période et applique les vitesses aux roues.
+     */
+    void updateProfile();
+
+    /**
+     * @brief Arrête le robot en suivant la rampe de décélération.
      */
     void stop();
 
     /**
-     * @brief Effectue un virage de 90 degrés.
-     * @param direction Direction du virage (gauche ou droite).
-     *        Permet de spécifier la direction du virage à effectuer.
+     * @brief Arrête les roues immédiatement, sans rampe.
+     *
+     * Pour s'arrêter sur une position précise (ligne visée d'une rotation) ou devant un obstacle.
      */
-    void turn90Degre(const Direction &direction);
+    void brake();
 
     /**
-     * @brief Effectue un demi-tour de 180 degrés.
-     * @param direction Direction initiale du demi-tour (gauche ou droite).
-     *        Indique la direction initiale du virage pour le demi-tour.
+     * @brief Indique si le robot est immobile et le restera (rampes terminées, consignes nulles).
+     * @return true si les deux profils de vitesse sont au repos.
      */
-    void turn180Degre(const Direction &direction);
+    bool isStopped() const;
 
     /**
-     * @brief Effectue un tour complet de 360 degrés.
-     * Le robot effectue un tour complet sur lui-même.
+     * @brief Fait tourner le robot sur place sans s'arrêter.
+     * @param direction Direction de la rotation (gauche ou droite).
+     *
+     * La rotation accélère jusqu'à la vitesse de virage. La méthode ne bloque pas: c'est à
+     * l'appelant d'arrêter la rotation, par exemple lorsque le capteur de ligne atteint la ligne
+     * visée.
      */
-    void turn360Degre();
+    void spin(const Direction &direction);
+
+    /**
+     * @brief Engage un virage en arc sans arrêter le robot.
+     * @param direction Direction du virage (gauche ou droite).
+     *
+     * Les deux roues avancent, la roue extérieure plus vite que la roue intérieure. La méthode ne
+     * bloque pas: c'est à l'appelant d'arrêter le virage lorsque la ligne est retrouvée.
+     */
+    void arcTurn(const Direction &direction);
 
 private:
     // -- -Constantes pour la configuration des ports-- -
@@ -96,34 +130,50 @@ private:
     static const uint8_t RIGHT_WHEEL_ENABLE = PB3; // ocr0A
     Wheel leftWheel_;                              // Objet Roue pour la roue gauche.
     Wheel rightWheel_;                             // Objet Roue pour la roue droite.
-    Timer<0> timer_;                               // Timer pour le PWM des roues
+    Timer<0> timer_;                               // Timer pour le PWM des roues et le cadencement de la commande
+    VelocityProfile linearProfile_;                // Profil de la vitesse d'avance (moyenne des deux roues).
+    VelocityProfile angularProfile_;               // Profil de la vitesse de rotation (demi-écart entre les roues).
+
+    /**
+     * @brief Change les consignes de vitesse des roues.
+     * @param speedLeft Vitesse de la roue gauche, négative en marche arrière.
+     * @param speedRight Vitesse de la roue droite, négative en marche arrière.
+     */
+    void setWheelTargets(int16_t speedLeft, int16_t speedRight);
+
+    /**
+     * @brief Applique une vitesse signée à une roue.
+     * @param wheel La roue.
+     * @param speed La vitesse, négative en marche arrière.
+     */
+    static void applyWheelSpeed(Wheel &wheel, int16_t speed);
 
     /**
      * @brief Fait tourner le robot vers la gauche.
      * @param speedLeft La vitesse à laquelle le roue gauche doit se déplacer.
      * @param speedRight La vitesse à laquelle le roue droite doit se déplacer.
      */
-    void turnLeft(const double speedLeft, const double speedRight);
+    void turnLeft(const DutyCycle &speedLeft, const DutyCycle &speedRight);
 
     /**
      * @brief Fait tourner le robot vers la droite.
      * @param speedLeft La vitesse à laquelle le roue gauche doit se déplacer.
      * @param speedRight La vitesse à laquelle le roue droite doit se déplacer.
      */
-    void turnRight(const double speedLeft, const double speedRight);
+    void turnRight(const DutyCycle &speedLeft, const DutyCycle &speedRight);
 
     /**
      * @brief Déplace le robot vers l'avant.
      * @param speedLeft La vitesse à laquelle le roue gauche doit se déplacer.
      * @param speedRight La vitesse à laquelle le roue droite doit se déplacer.
      */
-    void moveForward(const double speedLeft, const double speedRight);
+    void moveForward(const DutyCycle &speedLeft, const DutyCycle &speedRight);
 
     /**
      * @brief Déplace le robot vers l'arrière.
      * @param speedLeft La vitesse à laquelle le roue gauche doit se déplacer.
      * @param speedRight La vitesse à laquelle le roue droite doit se déplacer.
      */
-    void moveBackward(const double speedLeft, const double speedRight);
+    void moveBackward(const DutyCycle &speedLeft, const DutyCycle &speedRight);
 };
 #endif
\ No newline at end of file
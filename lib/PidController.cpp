@@ -0,0 +1,40 @@
+/**
+ * @file PidController.cpp
+ * @brief Implémentation de la classe PidController.
+ *
+ * Les produits gain x erreur sont calculés sur 32 bits puis ramenés à l'échelle de la commande par
+ * un décalage de PID_FRACTION_BITS.
+ */
+#include "PidController.hpp"
+
+PidController::PidController(int16_t kp, int16_t ki, int16_t kd, int16_t integralLimit)
+    : kp_(kp), ki_(ki), kd_(kd), integralLimit_(integralLimit), integral_(0), previousError_(0)
+{
+}
+
+int16_t PidController::update(int16_t error)
+{
+    int32_t integral = static_cast<int32_t>(integral_) + error;
+    if (integral > integralLimit_)
+        integral = integralLimit_;
+    else if (integral < -integralLimit_)
+        integral = -integralLimit_;
+    integral_ = static_cast<int16_t>(integral);
+
+    int32_t output = static_cast<int32_t>(kp_) * error + static_cast<int32_t>(ki_) * integral_ +
+                     static_cast<int32_t>(kd_) * (static_cast<int32_t>(error) - previousError_);
+    previousError_ = error;
+    output >>= PID_FRACTION_BITS;
+
+    if (output > INT16_MAX)
+        return INT16_MAX;
+    if (output < INT16_MIN)
+        return INT16_MIN;
+    return static_cast<int16_t>(output);
+}
+
+void PidController::reset()
+{
+    integral_ = 0;
+    previousError_ = 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file PidController.hpp
+ * @brief Définition de la classe PidController, un régulateur PID en virgule fixe.
+ *
+ * Le régulateur calcule une commande à partir d'une erreur entière, sans aucun calcul en virgule
+ * flottante: les gains sont des entiers au format Q8.8 (8 bits de partie fractionnaire), convertis
+ * à la compilation avec toPidGain.
+ */
+#ifndef PID_CONTROLLER_H
+#define PID_CONTROLLER_H
+
+#include <stdint.h>
+#include "interfaces/consts_lib.hpp"
+
+/**
+ * @class PidController
+ * @brief Régulateur proportionnel, intégral et dérivé en arithmétique entière.
+ *
+ * Chaque appel à update correspond à une période d'échantillonnage: l'intégrale est la somme des
+ * erreurs (bornée pour éviter l'emballement) et la dérivée l'écart avec l'erreur précédente.
+ */
+class PidController
+{
+public:
+    /**
+     * @brief Constructeur de PidController.
+     * @param kp Gain proportionnel (Q8.8).
+     * @param ki Gain intégral (Q8.8).
+     * @param kd Gain dérivé (Q8.8).
+     * @param integralLimit Valeur absolue maximale de la somme des erreurs.
+     */
+    PidController(int16_t kp, int16_t ki, int16_t kd, int16_t integralLimit);
+
+    /**
+     * @brief Destructeur par défaut de PidController.
+     */
+    ~PidController() = default;
+
+    /**
+     * @brief Calcule la commande pour une nouvelle erreur.
+     * @param error L'erreur mesurée (consigne moins mesure).
+     * @return int16_t La commande, saturée sur 16 bits.
+     */
+    int16_t update(int16_t error);
+
+    /**
+     * @brief Remet à zéro l'intégrale et l'erreur précédente.
+     *
+     * À appeler lorsque la mesure change brusquement de référence, par exemple après un virage.
+     */
+    void reset();
+
+private:
+    int16_t kp_;            // Gain proportionnel (Q8.8).
+    int16_t ki_;            // Gain intégral (Q8.8).
+    int16_t kd_;            // Gain dérivé (Q8.8).
+    int16_t integralLimit_; // Borne de la somme des erreurs.
+    int16_t integral_;      // Somme des erreurs.
+    int16_t previousError_; // Erreur de la période précédente.
+};
+
+#endif // PID_CONTROLLER_H
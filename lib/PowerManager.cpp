@@ -0,0 +1,63 @@
+/**
+ * @file PowerManager.cpp
+ * @brief Implémentation de la classe PowerManager.
+ */
+#include "PowerManager.hpp"
+#include <avr/interrupt.h>
+#include <avr/power.h>
+#include <avr/sleep.h>
+
+PowerManager::PowerManager() : isAdcDisabled_(false), isTimer2Disabled_(false)
+{
+}
+
+void PowerManager::sleep(SleepMode mode)
+{
+    set_sleep_mode(mode == SleepMode::POWER_DOWN ? SLEEP_MODE_PWR_DOWN : SLEEP_MODE_IDLE);
+    sleep_enable();
+    // sei n'active les interruptions qu'apres l'instruction suivante: aucun reveil n'est perdu
+    sei();
+    sleep_cpu();
+    sleep_disable();
+}
+
+void PowerManager::idle()
+{
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_mode();
+}
+
+void PowerManager::disableAdc()
+{
+    if (isAdcDisabled_)
+        return;
+    // l'ADC doit etre desactive avant de couper son horloge
+    ADCSRA &= ~(1 << ADEN);
+    power_adc_disable();
+    isAdcDisabled_ = true;
+}
+
+void PowerManager::enableAdc()
+{
+    if (!isAdcDisabled_)
+        return;
+    power_adc_enable();
+    ADCSRA |= (1 << ADEN);
+    isAdcDisabled_ = false;
+}
+
+void PowerManager::disableTimer2()
+{
+    if (isTimer2Disabled_)
+        return;
+    power_timer2_disable();
+    isTimer2Disabled_ = true;
+}
+
+void PowerManager::enableTimer2()
+{
+    if (!isTimer2Disabled_)
+        return;
+    power_timer2_enable();
+    isTimer2Disabled_ = false;
+}
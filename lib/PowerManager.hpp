@@ -0,0 +1,83 @@
+/**
+ * @file PowerManager.hpp
+ * @brief Définition de la classe PowerManager, mise en veille et coupure des périphériques.
+ *
+ * Les attentes (choix du mode, saisie de la destination, attentes de l'ordonnanceur) mettent le
+ * microcontrôleur en veille au lieu de boucler: le processeur ne consomme plus entre deux
+ * interruptions. Les périphériques inutilisés pendant la saisie (ADC, timer 2 du son) sont coupés
+ * par le registre PRR0.
+ *
+ * Description Materielle:
+ * - en mode IDLE, les timers continuent: le débordement du timer 0 réveille le processeur à
+ *   CONTROL_TICK_FREQUENCY_HZ.
+ * - en mode POWER_DOWN, le timer 0 (PWM des roues, horloge de ControlLoop) est arrêté: seules les
+ *   interruptions de changement de broche réveillent le processeur.
+ */
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <avr/io.h>
+#include "interfaces/emun/SleepMode.hpp"
+
+/**
+ * @class PowerManager
+ * @brief Met le microcontrôleur en veille et coupe l'ADC et le timer 2.
+ */
+class PowerManager
+{
+public:
+    /**
+     * @brief Constructeur de PowerManager: aucun périphérique n'est coupé.
+     */
+    PowerManager();
+
+    /**
+     * @brief Destructeur par défaut de PowerManager.
+     */
+    ~PowerManager() = default;
+
+    /**
+     * @brief Met le processeur en veille jusqu'à la prochaine interruption.
+     *
+     * Doit être appelée avec les interruptions désactivées, juste après avoir vérifié qu'aucun
+     * événement n'est en attente: une interruption survenue entre la vérification et la mise en
+     * veille réveille immédiatement le processeur. Retourne avec les interruptions activées.
+     *
+     * @param mode Le mode de veille.
+     */
+    static void sleep(SleepMode mode);
+
+    /**
+     * @brief Met le processeur en veille IDLE jusqu'à la prochaine interruption (interruptions activées).
+     *
+     * Pour les attentes sur l'horloge de ControlLoop: le prochain débordement du timer 0 réveille
+     * le processeur.
+     */
+    static void idle();
+
+    /**
+     * @brief Coupe l'ADC (convertisseur désactivé puis horloge coupée).
+     */
+    void disableAdc();
+
+    /**
+     * @brief Rétablit l'ADC coupé par disableAdc.
+     */
+    void enableAdc();
+
+    /**
+     * @brief Coupe le timer 2 (son). Il ne doit pas être en train de jouer une note.
+     */
+    void disableTimer2();
+
+    /**
+     * @brief Rétablit le timer 2 coupé par disableTimer2.
+     */
+    void enableTimer2();
+
+private:
+    bool isAdcDisabled_;    // L'ADC a été coupé par disableAdc.
+    bool isTimer2Disabled_; // Le timer 2 a été coupé par disableTimer2.
+};
+
+#endif // POWER_MANAGER_H
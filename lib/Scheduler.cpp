@@ -0,0 +1,97 @@
+/**
+ * @file Scheduler.cpp
+ * @brief Implémentation de la classe Scheduler.
+ *
+ * Les ticks sont comparés par différence signée: une mise en veille ne doit pas dépasser la moitié
+ * du cycle du compteur de débordements (SCHEDULER_MAX_WAIT_MS).
+ */
+#include "Scheduler.hpp"
+#include "PowerManager.hpp"
+
+static_assert(static_cast<uint32_t>(SCHEDULER_MAX_WAIT_MS) * 1000 / CONTROL_TICK_PERIOD_US < INT16_MAX,
+              "SCHEDULER_MAX_WAIT_MS depasse la moitie du cycle du compteur du timer 0");
+
+Scheduler::Scheduler(const ControlLoop *controlLoop) : controlLoop_(controlLoop), isRunningTasks_(false)
+{
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; ++i)
+        tasks_[i] = Task{nullptr, nullptr, 0, 0, 0, 0};
+}
+
+bool Scheduler::start(TaskFunction function, void *context)
+{
+    Task *freeTask = nullptr;
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; ++i)
+    {
+        if (tasks_[i].function == function)
+        {
+            freeTask = &tasks_[i];
+            break;
+        }
+        if (tasks_[i].function == nullptr && freeTask == nullptr)
+            freeTask = &tasks_[i];
+    }
+    if (freeTask == nullptr)
+        return false;
+    *freeTask = Task{function, context, 0, 0, controlLoop_->getTickCount(), 0};
+    return true;
+}
+
+void Scheduler::stop(TaskFunction function)
+{
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; ++i)
+    {
+        if (tasks_[i].function == function)
+            tasks_[i].function = nullptr;
+    }
+}
+
+bool Scheduler::isRunning(TaskFunction function) const
+{
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; ++i)
+    {
+        if (tasks_[i].function == function)
+            return true;
+    }
+    return false;
+}
+
+bool Scheduler::hasTasks() const
+{
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; ++i)
+    {
+        if (tasks_[i].function != nullptr)
+            return true;
+    }
+    return false;
+}
+
+void Scheduler::runPending()
+{
+    if (isRunningTasks_)
+        return;
+    isRunningTasks_ = true;
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; ++i)
+    {
+        Task &task = tasks_[i];
+        uint16_t now = controlLoop_->getTickCount();
+        if (task.function == nullptr || static_cast<int16_t>(now - task.wakeTick) < 0)
+            continue;
+        TaskFunction function = task.function;
+        if (function(task))
+            task.wakeTick = now + task.sleepTicks;
+        else if (task.function == function)
+            task.function = nullptr;
+    }
+    isRunningTasks_ = false;
+}
+
+void Scheduler::waitFor(const ControlTicks &duration)
+{
+    uint16_t deadline = controlLoop_->getTickCount() + duration.count();
+    while (static_cast<int16_t>(controlLoop_->getTickCount() - deadline) < 0)
+    {
+        runPending();
+        // le prochain debordement du timer 0 reveille le processeur
+        PowerManager::idle();
+    }
+}
@@ -0,0 +1,128 @@
+/**
+ * @file Scheduler.hpp
+ * @brief Définition de la classe Scheduler, ordonnanceur coopératif de tâches.
+ *
+ * Les routines longues (mélodies, messages affichés un temps donné, clignotements) s'écrivent comme
+ * des tâches qui se mettent en veille au lieu de bloquer le processeur. La boucle principale les
+ * reprend lorsqu'elle attend ou entre deux périodes de commande, de sorte que la détection, l'écran
+ * et le son continuent pendant les déplacements.
+ *
+ * Une tâche est une fonction de type protothread: ses variables locales ne sont pas conservées
+ * entre deux reprises (utiliser Task::counter ou l'objet Task::context).
+ *
+ *     bool blinkTask(Task &task)
+ *     {
+ *         TASK_BEGIN(task);
+ *         for (task.counter = 0; task.counter < 3; task.counter++)
+ *         {
+ *             ...
+ *             TASK_SLEEP(task, Milliseconds(500));
+ *         }
+ *         TASK_END(task);
+ *     }
+ *
+ * Le temps de l'ordonnanceur est le nombre de débordements du timer 0 (voir ControlLoop).
+ */
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include "interfaces/struct/Task.hpp"
+#include "interfaces/struct/Duration.hpp"
+#include "interfaces/consts_lib.hpp"
+#include "ControlLoop.hpp"
+
+// Débute le corps d'une tâche: reprend au dernier point de mise en veille.
+#define TASK_BEGIN(task)          \
+    switch ((task).resumePoint) \
+    {                             \
+    case 0:
+
+// Met la tâche en veille pour une durée, puis reprend à l'instruction suivante.
+#define TASK_SLEEP(task, duration)                            \
+    do                                                        \
+    {                                                         \
+        (task).sleepTicks = ControlTicks(duration).count();   \
+        (task).resumePoint = __LINE__;                        \
+        return true;                                          \
+    case __LINE__:;                                           \
+    } while (0)
+
+// Termine le corps d'une tâche.
+#define TASK_END(task)       \
+    }                        \
+    (task).resumePoint = 0; \
+    return false
+
+/**
+ * @class Scheduler
+ * @brief Ordonnanceur coopératif à tâches mises en veille jusqu'à un tick donné.
+ *
+ * Au plus SCHEDULER_MAX_TASKS tâches sont actives. Une tâche ne s'exécute que depuis runPending,
+ * jamais depuis une interruption: elle peut donc écrire sur l'écran ou jouer un son sans
+ * précaution particulière.
+ */
+class Scheduler
+{
+public:
+    /**
+     * @brief Constructeur de Scheduler.
+     * @param controlLoop La boucle de commande dont le compteur de débordements sert d'horloge.
+     */
+    Scheduler(const ControlLoop *controlLoop);
+
+    /**
+     * @brief Destructeur par défaut de Scheduler.
+     */
+    ~Scheduler() = default;
+
+    /**
+     * @brief Démarre une tâche, ou la redémarre depuis le début si elle est déjà active.
+     * @param function Le corps de la tâche.
+     * @param context L'objet passé à la tâche dans Task::context.
+     * @return bool Faux si toutes les places de tâche sont occupées.
+     */
+    bool start(TaskFunction function, void *context);
+
+    /**
+     * @brief Arrête une tâche sans attendre sa fin.
+     * @param function Le corps de la tâche.
+     */
+    void stop(TaskFunction function);
+
+    /**
+     * @brief Indique si une tâche est active.
+     * @param function Le corps de la tâche.
+     * @return bool Vrai si la tâche n'est pas terminée.
+     */
+    bool isRunning(TaskFunction function) const;
+
+    /**
+     * @brief Indique si au moins une tâche est active.
+     * @return bool Vrai si une tâche n'est pas terminée.
+     */
+    bool hasTasks() const;
+
+    /**
+     * @brief Reprend chaque tâche dont la mise en veille est écoulée.
+     *
+     * Sans effet si elle est appelée depuis une tâche.
+     */
+    void runPending();
+
+    /**
+     * @brief Attend une durée en reprenant les tâches pendant l'attente.
+     *
+     * Entre deux reprises, le processeur est mis en veille jusqu'au débordement suivant du timer 0.
+     *
+     * @param duration La durée, au plus SCHEDULER_MAX_WAIT_MS.
+     */
+    void waitFor(const ControlTicks &duration);
+
+private:
+    const ControlLoop *controlLoop_;      // Boucle de commande qui fournit l'horloge.
+    Task tasks_[SCHEDULER_MAX_TASKS];     // Tâches (function nulle pour une place libre).
+    bool isRunningTasks_;                 // Indique si runPending est en cours.
+};
+
+#endif // SCHEDULER_H
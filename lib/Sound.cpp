@@ -8,8 +8,67 @@
  */
 
 #include "Sound.hpp"
+#include <avr/pgmspace.h>
 
-Sound::Sound() : timer_(TimerMode::CTC, Prescaler::PRESCALER_256), isSongPlay_(false)
+// Note de melodie a partir d'un numero de note (voir consts_lib)
+static constexpr NoteMuic toNote(uint8_t noteNumber, uint16_t duration)
+{
+    return NoteMuic{static_cast<Note>(noteNumber), duration};
+}
+
+static constexpr NoteMuic toRest(uint16_t duration)
+{
+    return NoteMuic{Note::SILENCE, duration};
+}
+
+// Chanson Pirates des Caraibes: chaque note est suivie d'un silence de meme duree
+static const NoteMuic PIRATES_SONG[] PROGMEM = {
+    toNote(RE, NOIR), toNote(RE, NOIR), toNote(RE, CROCHE), toNote(MI, CROCHE),
+    toNote(FA, NOIR), toNote(FA, NOIR), toNote(FA, CROCHE), toNote(SOL, CROCHE),
+    toNote(MI, NOIR), toNote(MI, NOIR), toNote(RE, CROCHE), toNote(DO, CROCHE),
+    toNote(DO, CROCHE), toNote(RE, NOIR), toRest(CROCHE), toRest(CROCHE),
+    toNote(DO, CROCHE), toNote(RE, NOIR), toNote(RE, NOIR), toNote(RE, CROCHE),
+    toNote(MI, CROCHE), toNote(FA, NOIR), toNote(FA, NOIR), toNote(FA, CROCHE),
+    toNote(SOL, CROCHE), toNote(MI, NOIR), toNote(MI, NOIR), toNote(RE, CROCHE),
+    toNote(DO, CROCHE), toNote(RE, NOIR), toRest(NOIR), toRest(CROCHE),
+    toNote(DO, CROCHE), toNote(RE, NOIR), toNote(RE, NOIR), toNote(RE, CROCHE),
+    toNote(FA, CROCHE), toNote(SOL, NOIR), toNote(SOL, NOIR), toNote(SOL, CROCHE),
+    toNote(HIGH_LA, CROCHE), toNote(SI_BEMOL, NOIR), toNote(SI_BEMOL, NOIR), toNote(HIGH_LA, CROCHE),
+    toNote(SOL, CROCHE), toNote(HIGH_LA, CROCHE), toNote(RE, NOIR), toRest(CROCHE),
+    toNote(RE, CROCHE), toNote(MI, CROCHE), toNote(FA, CROCHE), toNote(FA, NOIR),
+    toNote(SOL, NOIR), toNote(HIGH_LA, CROCHE), toNote(RE, NOIR), toRest(CROCHE),
+    toNote(RE, CROCHE), toNote(FA, CROCHE), toNote(MI, NOIR), toNote(MI, NOIR),
+    toNote(FA, CROCHE), toNote(RE, CROCHE), toNote(MI, NOIR), toRest(NOIR),
+};
+static const uint8_t PIRATES_SONG_LENGTH = sizeof(PIRATES_SONG) / sizeof(PIRATES_SONG[0]);
+
+static const Prescaler SOUND_PRESCALER = Prescaler::PRESCALER_256;
+static const uint8_t FIRST_NOTE = static_cast<uint8_t>(Note::A2);
+static const uint8_t N_NOTES = sizeof(noteFrequencies) / sizeof(noteFrequencies[0]);
+
+static_assert(getCtcSignalOcr(noteFrequencies[0], SOUND_PRESCALER) <= UINT8_MAX, "La note la plus grave depasse le registre OCR2A");
+
+/**
+ * @struct NoteOcrTable
+ * @brief Valeur de OCR2A précalculée pour chaque note.
+ */
+struct NoteOcrTable
+{
+    uint8_t values[N_NOTES]; // Valeur de OCR2A de chaque note, a partir de FIRST_NOTE.
+};
+
+static constexpr NoteOcrTable buildNoteOcrTable()
+{
+    NoteOcrTable table = {};
+    for (uint8_t note = 0; note < N_NOTES; ++note)
+        table.values[note] = static_cast<uint8_t>(getCtcSignalOcr(noteFrequencies[note], SOUND_PRESCALER));
+    return table;
+}
+
+// les frequences sont converties a la compilation: jouer une note ne fait aucun calcul en virgule flottante
+static constexpr NoteOcrTable noteOcrTable PROGMEM = buildNoteOcrTable();
+
+Sound::Sound() : timer_(TimerMode::CTC, SOUND_PRESCALER), isSongPlay_(false)
 {
     setRegisterBits(&DDRD, PD6);
     clearRegisterBits(&PORTD, PD6);
@@ -18,7 +77,7 @@ Sound::Sound() : timer_(TimerMode::CTC, Prescaler::PRESCALER_256), isSongPlay_(f
 
 void Sound::play(uint8_t noteNumber)
 {
-    if ((noteNumber >= 45) && (noteNumber <= 81))
+    if ((noteNumber >= FIRST_NOTE) && (noteNumber < FIRST_NOTE + N_NOTES))
     {
         if (!isSongPlay_)
         {
@@ -27,7 +86,7 @@ void Sound::play(uint8_t noteNumber)
             // setRegisterBits(&PORTD, PD7);
             isSongPlay_ = true;
         }
-        timer_.setOCRnXCtcToGenerateSignal(noteFrequencies[noteNumber - 45], &OCR2A);
+        OCR2A = pgm_read_byte(&noteOcrTable.values[noteNumber - FIRST_NOTE]);
     }
 }
 
@@ -38,327 +97,34 @@ void Sound::stop()
     clearRegisterBits(&PORTD, PD7);
 }
 
+uint8_t Sound::getPiratesSongLength()
+{
+    return PIRATES_SONG_LENGTH;
+}
+
+NoteMuic Sound::getPiratesSongNote(uint8_t index)
+{
+    return NoteMuic{static_cast<Note>(pgm_read_byte(&PIRATES_SONG[index].note)), pgm_read_word(&PIRATES_SONG[index].duration)};
+}
+
+void Sound::playNote(const NoteMuic &note)
+{
+    if (note.note == Note::SILENCE)
+        stop();
+    else
+        play(static_cast<uint8_t>(note.note));
+}
+
 void Sound::playPiratesDesCaraibesSong()
 {
-    // Re noire
-    play(RE);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Re noire
-    play(RE);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Re croche
-    play(RE);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // // Mi croche
-    play(MI);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // // Fa noire
-    play(FA);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // // Fa noire
-    play(FA);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // // Fa croche
-    play(FA);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // // Sol croche
-    play(SOL);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // // MI noire
-    play(MI);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // // MI noire
-    play(MI);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // // Re croche
-    play(RE);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // // Do croche
-    play(DO);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // // Do croche
-    play(DO);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // // Re noire
-    play(RE);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // // Silence croche
-    stop();
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // La bas croche
-    stop();
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Do croche
-    play(DO);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Re noire
-    play(RE);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Re noire
-    play(RE);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Re croche
-    play(RE);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Mi croche
-    play(MI);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Fa noire
-    play(FA);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Fa  noire
-    play(FA);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Fa croche
-    play(FA);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Sol croche
-    play(SOL);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Mi noire
-    play(MI);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Mi noire
-    play(MI);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Re croche
-    play(RE);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Do croche
-    play(DO);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Re noire
-    play(RE);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Silence noire
-    stop();
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // La bas croche
-    stop();
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Do croche
-    play(DO);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Re noire
-    play(RE);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Re noire
-    play(RE);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Re croche
-    play(RE);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Fa croche
-    play(FA);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Sol noire
-    play(SOL);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Sol noire
-    play(SOL);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Sol croche
-    play(SOL);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // La haut croche
-    play(HIGH_LA);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Si haut noire
-    play(SI_BEMOL);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Si haut noire
-    play(SI_BEMOL);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // La haut croche
-    play(HIGH_LA);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Sol croche
-    play(SOL);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // La haut croche
-    play(HIGH_LA);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Re noire
-    play(RE);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Silence croche
-    stop();
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Re croche
-    play(RE);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Mi croche
-    play(MI);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Fa noire
-    play(FA);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Fa noire
-    play(FA);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Sol noire
-    play(SOL);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // La haut croche
-    play(HIGH_LA);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Re noire
-    play(RE);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Silence croche
-    stop();
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Re croche
-    play(RE);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Fa croche
-    play(FA);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Mi noire
-    play(MI);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Mi noire
-    play(MI);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Fa croche
-    play(FA);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Re croche
-    play(RE);
-    _delay_ms(CROCHE);
-    stop();
-    _delay_ms(CROCHE);
-    // Mi noire
-    play(MI);
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    // Silence noire
-    stop();
-    _delay_ms(NOIR);
-    stop();
-    _delay_ms(NOIR);
-    stop();
-}
\ No newline at end of file
+    for (uint8_t i = 0; i < PIRATES_SONG_LENGTH; i++)
+    {
+        NoteMuic note = getPiratesSongNote(i);
+        playNote(note);
+        for (uint16_t elapsedMs = 0; elapsedMs < note.duration; elapsedMs++)
+            _delay_ms(1);
+        stop();
+        for (uint16_t elapsedMs = 0; elapsedMs < note.duration; elapsedMs++)
+            _delay_ms(1);
+    }
+}
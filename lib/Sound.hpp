@@ -17,6 +17,7 @@
 #include "Timer.hpp"
 #include "util/delay.h"
 #include "interfaces/emun/NoteFrequency.hpp"
+#include "interfaces/struct/NoteMusic.hpp"
 #include "interfaces/consts_lib.hpp"
 
 // le pin de signal est PD7
@@ -45,11 +46,36 @@ public:
      */
     void play(uint8_t noteNumber);
 
+    /**
+     * @brief Joue une note d'une mélodie, ou arrête le son pour un silence.
+     * @param note La note à jouer.
+     */
+    void playNote(const NoteMuic &note);
+
     /**
      * @brief Joue le song du film pirates des caraibes
+     *
+     * Bloque pendant toute la chanson; pour jouer en parallèle d'autres routines, jouer les notes
+     * de getPiratesSongNote depuis une tâche (voir Scheduler).
      */
     void playPiratesDesCaraibesSong();
 
+    /**
+     * @brief Retourne le nombre de notes de la chanson pirates des caraibes.
+     * @return uint8_t Le nombre de notes.
+     */
+    static uint8_t getPiratesSongLength();
+
+    /**
+     * @brief Lit une note de la chanson pirates des caraibes en mémoire flash.
+     *
+     * Chaque note est suivie d'un silence de même durée.
+     *
+     * @param index L'indice de la note.
+     * @return NoteMuic La note et sa durée en millisecondes.
+     */
+    static NoteMuic getPiratesSongNote(uint8_t index);
+
     /**
      * @brief Arrête de jouer la note musicale.
      */
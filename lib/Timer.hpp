@@ -18,9 +18,27 @@
 #ifndef TIMER_H
 #define TIMER_H
 #include "interfaces/TimerConfig.hpp"
+#include "interfaces/struct/DutyCycle.hpp"
+#include "interfaces/struct/Duration.hpp"
 
 constexpr uint64_t FREQUENCY = 8000000UL;
 
+/**
+ * @brief Calcule la valeur OCR qui génère en mode CTC un signal carré (rapport cyclique de 50%)
+ * d'une fréquence donnée.
+ *
+ * À n'appeler que dans une expression constante (tables précalculées): le calcul en virgule
+ * flottante est fait à la compilation.
+ *
+ * @param frequency Fréquence du signal à générer, en Hertz.
+ * @param prescaler Prédiviseur du timer.
+ * @return uint16_t La valeur du registre OCR.
+ */
+constexpr uint16_t getCtcSignalOcr(double frequency, Prescaler prescaler)
+{
+    return static_cast<uint16_t>(FREQUENCY / (2 * static_cast<uint16_t>(prescaler) * frequency) - 1);
+}
+
 /**
  * @brief Classe Timer templatisée pour fournir des fonctionnalités pour différents timers.
  *
@@ -58,41 +76,42 @@ public:
     void changePrescaler(const Prescaler &prescaler);
 
     /**
-     * @brief Configure le registre OCR pour un timer 16 bits.
+     * @brief Configure le registre OCR pour un timer 16 bits en mode CTC.
      *
-     * @param value Valeur à mettre dans le registre.
+     * @param period Durée entre deux interruptions.
      * @param OCRnXRegister Pointeur vers le registre OCR à configurer.
      */
-    void setOCRnXRegister(double value, volatile uint16_t *OCRnXRegister);
+    void setOCRnXRegister(const Milliseconds &period, volatile uint16_t *OCRnXRegister);
 
     /**
-     * @brief Configure le registre OCR pour un timer 8 bits.
+     * @brief Configure le registre OCR pour un timer 8 bits en mode CTC.
      *
-     * @param value Valeur à mettre dans le registre.
+     * @param period Durée entre deux interruptions.
      * @param OCRnXRegister Pointeur vers le registre OCR à configurer.
      */
-    void setOCRnXRegister(double value, volatile uint8_t *OCRnXRegister);
+    void setOCRnXRegister(const Milliseconds &period, volatile uint8_t *OCRnXRegister);
 
     /**
-     * @brief Configure le registre OCR pour un timer 8 bits (principalement utilisées pour generer un signal PWM avec un dutyCycle de 50%
-     * avec une certaine frequence).
+     * @brief Configure le rapport cyclique d'un timer 16 bits en mode PWM.
      *
-     * @param frequence frequence du signal à generer.
+     * @param dutyCycle Rapport cyclique en virgule fixe, écrit tel quel dans le registre.
      * @param OCRnXRegister Pointeur vers le registre OCR à configurer.
      */
-    void setOCRnXCtcToGenerateSignal(double frequency, volatile uint8_t *OCRnXRegister);
+    void setOCRnXRegister(const DutyCycle &dutyCycle, volatile uint16_t *OCRnXRegister);
 
     /**
-     * @brief Configure le registre OCR pour un timer 16 bits (principalement utilisées pour generer un signal PWM avec un dutyCycle de 50%
-     * avec une certaine frequence).
+     * @brief Configure le rapport cyclique d'un timer 8 bits en mode PWM.
      *
-     * @param frequence frequence du signal à generer.
-     * @param OCRnXRegister Pointeur vers le registre OCR à configurer
+     * @param dutyCycle Rapport cyclique en virgule fixe, écrit tel quel dans le registre.
+     * @param OCRnXRegister Pointeur vers le registre OCR à configurer.
      */
-    void setOCRnXCtcToGenerateSignal(double frequency, volatile uint16_t *OCRnXRegister);
+    void setOCRnXRegister(const DutyCycle &dutyCycle, volatile uint8_t *OCRnXRegister);
 
     /**
      * @brief Active les interruptions du timer.
+     *
+     * En mode CTC, l'interruption de comparaison; en mode normal ou PWM, l'interruption de
+     * débordement.
      */
     void enable();
 
@@ -102,43 +121,26 @@ public:
     void disable();
 
 private:
-    static const uint8_t MAX_PWM_COUNT_VALUE = 255; // Valeur maximale de comptage pour le mode PWM.
-    TimerMode mode_;                                // Mode actuel du timer.
-    Prescaler prescaler_;                           // Valeur actuelle du prescaler.
+    TimerMode mode_;      // Mode actuel du timer.
+    Prescaler prescaler_; // Valeur actuelle du prescaler.
 
     // Méthodes privées pour configurer le registre OCR en fonction du mode du timer.
 
-    /**
-     * @brief Configure le registre OCR pour un timer 16 bits en mode PWM.
-     *
-     * @param dutyCycle Valeur de rapport cyclique entre 0.0 et 1.0.
-     * @param OCRnXRegister Pointeur vers le registre OCR à configurer.
-     */
-    void setOCRnXPwmModeRegister(double dutyCycle, volatile uint16_t *OCRnXRegister);
-
     /**
      * @brief Configure le registre OCR pour un timer 16 bits en mode CTC.
      *
-     * @param duration_s Durée en secondes pour laquelle le timer doit déclencher une interruption.
-     * @param OCRnXRegister Pointeur vers le registre OCR à configurer.
-     */
-    void setOCRnXCtcModeRegister(double duration_s, volatile uint16_t *OCRnXRegister);
-
-    /**
-     * @brief Configure le registre OCR pour un timer 8 bits en mode PWM.
-     *
-     * @param dutyCycle Valeur de rapport cyclique entre 0.0 et 1.0.
+     * @param period Durée après laquelle le timer doit déclencher une interruption.
      * @param OCRnXRegister Pointeur vers le registre OCR à configurer.
      */
-    void setOCRnXPwmModeRegister(double dutyCycle, volatile uint8_t *OCRnXRegister);
+    void setOCRnXCtcModeRegister(const Milliseconds &period, volatile uint16_t *OCRnXRegister);
 
     /**
      * @brief Configure le registre OCR pour un timer 8 bits en mode CTC.
      *
-     * @param durationS Durée en secondes pour laquelle le timer doit déclencher une interruption.
+     * @param period Durée après laquelle le timer doit déclencher une interruption.
      * @param OCRnXRegister Pointeur vers le registre OCR à configurer.
      */
-    void setOCRnXCtcModeRegister(double durationS, volatile uint8_t *OCRnXRegister);
+    void setOCRnXCtcModeRegister(const Milliseconds &period, volatile uint8_t *OCRnXRegister);
 };
 
 template <uint8_t TIMER_NUM>
@@ -163,43 +165,39 @@ void Timer<TIMER_NUM>::changePrescaler(const Prescaler &prescaler)
 }
 
 template <uint8_t TIMER_NUM>
-void Timer<TIMER_NUM>::setOCRnXRegister(double value, volatile uint16_t *OCRnXRegister)
+void Timer<TIMER_NUM>::setOCRnXRegister(const Milliseconds &period, volatile uint16_t *OCRnXRegister)
 {
-    if (mode_ == TimerMode::PWM)
-    {
-        setOCRnXPwmModeRegister(value, OCRnXRegister);
-    }
-    else if (mode_ == TimerMode::CTC)
+    if (mode_ == TimerMode::CTC)
     {
-        setOCRnXCtcModeRegister(value, OCRnXRegister);
+        setOCRnXCtcModeRegister(period, OCRnXRegister);
     }
 }
 
 template <uint8_t TIMER_NUM>
-void Timer<TIMER_NUM>::setOCRnXRegister(double value, volatile uint8_t *OCRnXRegister)
+void Timer<TIMER_NUM>::setOCRnXRegister(const DutyCycle &dutyCycle, volatile uint16_t *OCRnXRegister)
 {
     if (mode_ == TimerMode::PWM)
     {
-        setOCRnXPwmModeRegister(value, OCRnXRegister);
-    }
-    else if (mode_ == TimerMode::CTC)
-    {
-        setOCRnXCtcModeRegister(value, OCRnXRegister);
+        *OCRnXRegister = dutyCycle.value;
     }
 }
 
 template <uint8_t TIMER_NUM>
-void Timer<TIMER_NUM>::setOCRnXCtcToGenerateSignal(double frequency, volatile uint8_t *OCRnXRegister)
+void Timer<TIMER_NUM>::setOCRnXRegister(const Milliseconds &period, volatile uint8_t *OCRnXRegister)
 {
-    uint8_t ocrValue = static_cast<uint8_t>((FREQUENCY / (2 * static_cast<uint16_t>(prescaler_) * frequency)) - 1);
-    *OCRnXRegister = ocrValue;
+    if (mode_ == TimerMode::CTC)
+    {
+        setOCRnXCtcModeRegister(period, OCRnXRegister);
+    }
 }
 
 template <uint8_t TIMER_NUM>
-void Timer<TIMER_NUM>::setOCRnXCtcToGenerateSignal(double frequency, volatile uint16_t *OCRnXRegister)
+void Timer<TIMER_NUM>::setOCRnXRegister(const DutyCycle &dutyCycle, volatile uint8_t *OCRnXRegister)
 {
-    uint8_t ocrValue = static_cast<uint8_t>((FREQUENCY / (2 * static_cast<uint16_t>(prescaler_) * frequency)) - 1);
-    *OCRnXRegister = ocrValue;
+    if (mode_ == TimerMode::PWM)
+    {
+        *OCRnXRegister = dutyCycle.value;
+    }
 }
 
 template <uint8_t TIMER_NUM>
@@ -241,6 +239,16 @@ void Timer<TIMER_NUM>::enable()
             setRegisterBits(&TIMSK2, TOIE2);
         }
     }
+    else if (mode_ == TimerMode::PWM)
+    {
+        // le compteur n'est pas remis a zero pour ne pas perturber le signal PWM
+        if (TIMER_NUM == 0)
+            setRegisterBits(&TIMSK0, TOIE0);
+        else if (TIMER_NUM == 1)
+            setRegisterBits(&TIMSK1, TOIE1);
+        else if (TIMER_NUM == 2)
+            setRegisterBits(&TIMSK2, TOIE2);
+    }
 }
 
 template <uint8_t TIMER_NUM>
@@ -255,7 +263,7 @@ void Timer<TIMER_NUM>::disable()
         else if (TIMER_NUM == 2)
             clearRegisterBits(&TIMSK2, OCIE2A);
     }
-    else if (mode_ == TimerMode::NORMAL)
+    else if (mode_ == TimerMode::NORMAL || mode_ == TimerMode::PWM)
     {
         if (TIMER_NUM == 0)
             clearRegisterBits(&TIMSK0, TOIE0);
@@ -267,27 +275,17 @@ void Timer<TIMER_NUM>::disable()
 }
 
 template <uint8_t TIMER_NUM>
-void Timer<TIMER_NUM>::setOCRnXPwmModeRegister(double dutyCycle, volatile uint16_t *OCRnXRegister)
-{
-    *OCRnXRegister = static_cast<uint16_t>(dutyCycle * MAX_PWM_COUNT_VALUE);
-}
-
-template <uint8_t TIMER_NUM>
-void Timer<TIMER_NUM>::setOCRnXCtcModeRegister(double duration_s, volatile uint16_t *OCRnXRegister)
-{
-    *OCRnXRegister = static_cast<uint16_t>(duration_s * FREQUENCY / static_cast<uint16_t>(prescaler_));
-}
-
-template <uint8_t TIMER_NUM>
-void Timer<TIMER_NUM>::setOCRnXPwmModeRegister(double dutyCycle, volatile uint8_t *OCRnXRegister)
+void Timer<TIMER_NUM>::setOCRnXCtcModeRegister(const Milliseconds &period, volatile uint16_t *OCRnXRegister)
 {
-    *OCRnXRegister = static_cast<uint8_t>(dutyCycle * MAX_PWM_COUNT_VALUE);
+    // calcul entier: nombre de cycles d'horloge par milliseconde, divise par le prescaler
+    *OCRnXRegister = static_cast<uint16_t>(period.count() * static_cast<uint32_t>(FREQUENCY / 1000) / static_cast<uint16_t>(prescaler_));
 }
 
 template <uint8_t TIMER_NUM>
-void Timer<TIMER_NUM>::setOCRnXCtcModeRegister(double duration_s, volatile uint8_t *OCRnXRegister)
+void Timer<TIMER_NUM>::setOCRnXCtcModeRegister(const Milliseconds &period, volatile uint8_t *OCRnXRegister)
 {
-    *OCRnXRegister = static_cast<uint8_t>(duration_s * FREQUENCY / static_cast<uint16_t>(prescaler_));
+    // calcul entier: nombre de cycles d'horloge par milliseconde, divise par le prescaler
+    *OCRnXRegister = static_cast<uint8_t>(period.count() * static_cast<uint32_t>(FREQUENCY / 1000) / static_cast<uint16_t>(prescaler_));
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,131 @@
+/**
+ * @file TimerWheel.cpp
+ * @brief Implémentation de la classe TimerWheel.
+ *
+ * Les minuteries sont modifiées par la boucle principale et par l'interruption de la roue: les
+ * méthodes publiques appelées hors interruption travaillent en section critique.
+ */
+#include "TimerWheel.hpp"
+#include <util/atomic.h>
+
+TimerWheel::TimerWheel() : timers_{}, nTimers_(0), now_(0)
+{
+    for (uint8_t i = 0; i < TIMER_WHEEL_SLOTS; i++)
+        slots_[i] = TIMER_WHEEL_NO_TIMER;
+}
+
+uint8_t TimerWheel::create(TimerCallback callback, void *context)
+{
+    if (nTimers_ >= TIMER_WHEEL_MAX_TIMERS)
+        return TIMER_WHEEL_NO_TIMER;
+    SoftTimer &softTimer = timers_[nTimers_];
+    softTimer.callback = callback;
+    softTimer.context = context;
+    softTimer.isActive = false;
+    softTimer.next = TIMER_WHEEL_NO_TIMER;
+    return nTimers_++;
+}
+
+void TimerWheel::start(uint8_t timer, const WheelTicks &delay, const WheelTicks &period)
+{
+    if (timer >= nTimers_)
+        return;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        SoftTimer &softTimer = timers_[timer];
+        if (softTimer.isActive)
+            remove(timer);
+        // un delai nul echoirait au tick courant, deja traite
+        softTimer.expiry = now_ + ((delay.count() == 0) ? 1 : delay.count());
+        softTimer.period = period.count();
+        softTimer.isActive = true;
+        insert(timer);
+    }
+}
+
+void TimerWheel::stop(uint8_t timer)
+{
+    if (timer >= nTimers_)
+        return;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (timers_[timer].isActive)
+        {
+            remove(timer);
+            timers_[timer].isActive = false;
+        }
+    }
+}
+
+bool TimerWheel::isActive(uint8_t timer) const
+{
+    return timer < nTimers_ && timers_[timer].isActive;
+}
+
+bool TimerWheel::hasActiveTimers() const
+{
+    for (uint8_t i = 0; i < nTimers_; i++)
+    {
+        if (timers_[i].isActive)
+            return true;
+    }
+    return false;
+}
+
+void TimerWheel::tick()
+{
+    uint16_t now = now_ + 1;
+    now_ = now;
+
+    // les minuteries echues sont d'abord retirees de la case: leurs fonctions peuvent rearmer
+    // ou arreter n'importe quelle minuterie
+    uint8_t expired[TIMER_WHEEL_MAX_TIMERS];
+    uint8_t nExpired = 0;
+    uint8_t *link = &slots_[now & (TIMER_WHEEL_SLOTS - 1)];
+    while (*link != TIMER_WHEEL_NO_TIMER)
+    {
+        SoftTimer &softTimer = timers_[*link];
+        if (softTimer.expiry == now)
+        {
+            expired[nExpired++] = *link;
+            *link = softTimer.next;
+        }
+        else
+            link = &softTimer.next;
+    }
+
+    for (uint8_t i = 0; i < nExpired; i++)
+    {
+        SoftTimer &softTimer = timers_[expired[i]];
+        if (softTimer.period != 0)
+        {
+            softTimer.expiry = now + softTimer.period;
+            insert(expired[i]);
+        }
+        else
+            softTimer.isActive = false;
+    }
+    for (uint8_t i = 0; i < nExpired; i++)
+        timers_[expired[i]].callback(timers_[expired[i]].context);
+}
+
+void TimerWheel::insert(uint8_t timer)
+{
+    uint8_t slot = timers_[timer].expiry & (TIMER_WHEEL_SLOTS - 1);
+    timers_[timer].next = slots_[slot];
+    slots_[slot] = timer;
+}
+
+void TimerWheel::remove(uint8_t timer)
+{
+    uint8_t *link = &slots_[timers_[timer].expiry & (TIMER_WHEEL_SLOTS - 1)];
+    while (*link != TIMER_WHEEL_NO_TIMER)
+    {
+        if (*link == timer)
+        {
+            *link = timers_[timer].next;
+            return;
+        }
+        link = &timers_[*link].next;
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file TimerWheel.hpp
+ * @brief Définition de la classe TimerWheel, roue de minuteries logicielles.
+ *
+ * Plusieurs échéances (délai d'un segment, attente avant une décision, clignotement) coexistent
+ * sur une seule interruption du timer 1 (voir MonotonicClock), au lieu de partager un unique
+ * compteur. Chaque minuterie appelle sa fonction à l'échéance, une fois ou périodiquement.
+ *
+ * La roue compte TIMER_WHEEL_SLOTS cases; une minuterie est rangée dans la case de son tick
+ * d'échéance modulo le nombre de cases. À chaque tick, seule la case courante est parcourue: le
+ * coût d'un tick ne dépend que du nombre de minuteries rangées dans cette case.
+ *
+ * @note tick() doit être appelée toutes les TIMER_WHEEL_TICK_US microsecondes, depuis
+ * l'interruption TIMER1_COMPA_vect. Les fonctions des minuteries s'exécutent dans cette
+ * interruption: elles doivent être brèves (drapeaux, LED, événements).
+ */
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+#include "interfaces/struct/SoftTimer.hpp"
+#include "interfaces/struct/Duration.hpp"
+#include "interfaces/consts_lib.hpp"
+
+// Durée en ticks de la roue des minuteries.
+using WheelTicks = Ticks<TIMER_WHEEL_TICK_US>;
+
+/**
+ * @class TimerWheel
+ * @brief Roue de minuteries à une seule échéance ou périodiques, à la résolution de TIMER_WHEEL_TICK_US.
+ */
+class TimerWheel
+{
+public:
+    /**
+     * @brief Constructeur de TimerWheel: aucune minuterie n'est créée.
+     */
+    TimerWheel();
+
+    /**
+     * @brief Destructeur par défaut de TimerWheel.
+     */
+    ~TimerWheel() = default;
+
+    /**
+     * @brief Crée une minuterie, désarmée.
+     * @param callback Fonction appelée à chaque échéance.
+     * @param context Paramètre passé à la fonction.
+     * @return uint8_t L'identifiant de la minuterie, ou TIMER_WHEEL_NO_TIMER si TIMER_WHEEL_MAX_TIMERS est atteint.
+     */
+    uint8_t create(TimerCallback callback, void *context);
+
+    /**
+     * @brief Arme une minuterie, ou la réarme si elle l'est déjà.
+     * @param timer L'identifiant de la minuterie.
+     * @param delay Le délai avant la première échéance (au moins un tick), au plus TIMER_WHEEL_MAX_DELAY_MS.
+     * @param period La période des échéances suivantes, 0 pour une seule échéance.
+     */
+    void start(uint8_t timer, const WheelTicks &delay, const WheelTicks &period = WheelTicks(0));
+
+    /**
+     * @brief Désarme une minuterie (sans effet si elle ne l'est pas).
+     * @param timer L'identifiant de la minuterie.
+     */
+    void stop(uint8_t timer);
+
+    /**
+     * @brief Indique si une minuterie est armée.
+     * @param timer L'identifiant de la minuterie.
+     * @return true si une échéance est à venir.
+     */
+    bool isActive(uint8_t timer) const;
+
+    /**
+     * @brief Indique si au moins une minuterie est armée.
+     * @return true si une échéance est à venir.
+     */
+    bool hasActiveTimers() const;
+
+    /**
+     * @brief Avance la roue d'un tick et appelle les fonctions des minuteries échues (interruption).
+     */
+    void tick();
+
+private:
+    /**
+     * @brief Range une minuterie armée dans la case de son échéance.
+     * @param timer L'identifiant de la minuterie.
+     */
+    void insert(uint8_t timer);
+
+    /**
+     * @brief Retire une minuterie de la case de son échéance.
+     * @param timer L'identifiant de la minuterie.
+     */
+    void remove(uint8_t timer);
+
+    SoftTimer timers_[TIMER_WHEEL_MAX_TIMERS]; // Minuteries créées.
+    uint8_t slots_[TIMER_WHEEL_SLOTS];         // Première minuterie de chaque case.
+    uint8_t nTimers_;                          // Nombre de minuteries créées.
+    volatile uint16_t now_;                    // Tick courant de la roue.
+};
+
+#endif // TIMER_WHEEL_H
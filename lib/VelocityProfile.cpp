@@ -0,0 +1,68 @@
+/**
+ * @file VelocityProfile.cpp
+ * @brief Implémentation de la classe VelocityProfile.
+ *
+ * Avec une limite de jerk, l'accélération diminue avant la consigne: dès que l'écart restant ne
+ * suffit plus qu'à ramener l'accélération à zéro (a^2 / 2j), elle décroît d'un pas de jerk par
+ * période. La vitesse arrive ainsi sur la consigne sans la dépasser.
+ */
+#include "VelocityProfile.hpp"
+
+static_assert(static_cast<int32_t>(DUTY_CYCLE_MAX) * 2 << PROFILE_FRACTION_BITS < INT32_MAX / 2,
+              "PROFILE_FRACTION_BITS trop grand pour les vitesses sur 32 bits");
+
+VelocityProfile::VelocityProfile(uint16_t maxAcceleration, uint16_t maxJerk)
+    : maxAcceleration_(maxAcceleration), maxJerk_(maxJerk), target_(0), velocity_(0), acceleration_(0)
+{
+}
+
+void VelocityProfile::setTarget(int16_t velocity)
+{
+    target_ = static_cast<int32_t>(velocity) << PROFILE_FRACTION_BITS;
+}
+
+void VelocityProfile::reset(int16_t velocity)
+{
+    target_ = static_cast<int32_t>(velocity) << PROFILE_FRACTION_BITS;
+    velocity_ = target_;
+    acceleration_ = 0;
+}
+
+int16_t VelocityProfile::update()
+{
+    int32_t error = target_ - velocity_;
+    int32_t direction = (error >= 0) ? 1 : -1;
+    uint32_t distance = static_cast<uint32_t>(error * direction);
+
+    if (maxJerk_ == 0)
+        acceleration_ = direction * maxAcceleration_;
+    else
+    {
+        // accélération dans le sens de l'écart (négative si elle l'agrandit)
+        int32_t towardTarget = acceleration_ * direction;
+        uint32_t brakingDistance = (towardTarget > 0) ? static_cast<uint32_t>(towardTarget * towardTarget) / (2UL * maxJerk_) : 0;
+        if (towardTarget > 0 && distance <= brakingDistance)
+            towardTarget -= maxJerk_;
+        else if (towardTarget + maxJerk_ <= maxAcceleration_)
+            towardTarget += maxJerk_;
+        else
+            towardTarget = maxAcceleration_;
+        acceleration_ = towardTarget * direction;
+    }
+
+    // la consigne est atteinte (ou dépassée) pendant cette période
+    int32_t step = acceleration_ * direction;
+    if (step >= static_cast<int32_t>(distance) || distance <= maxJerk_)
+    {
+        velocity_ = target_;
+        acceleration_ = 0;
+    }
+    else
+        velocity_ += acceleration_;
+    return static_cast<int16_t>(velocity_ >> PROFILE_FRACTION_BITS);
+}
+
+bool VelocityProfile::isAtRest() const
+{
+    return target_ == 0 && velocity_ == 0 && acceleration_ == 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file VelocityProfile.hpp
+ * @brief Définition de la classe VelocityProfile, profil de vitesse à accélération et jerk limités.
+ *
+ * Un changement de consigne de vitesse n'est pas appliqué d'un coup aux roues: la vitesse rejoint la
+ * consigne avec une accélération bornée, elle-même atteinte progressivement (jerk borné). Le profil
+ * est trapézoïdal sans limite de jerk, en S avec.
+ */
+#ifndef VELOCITY_PROFILE_H
+#define VELOCITY_PROFILE_H
+
+#include <stdint.h>
+#include "interfaces/consts_lib.hpp"
+
+/**
+ * @class VelocityProfile
+ * @brief Profil de vitesse d'un axe, mis à jour une fois par période de commande.
+ *
+ * Les vitesses sont en unités de rapport cyclique signées (de -DUTY_CYCLE_MAX à DUTY_CYCLE_MAX).
+ * La vitesse et l'accélération sont gardées en virgule fixe avec PROFILE_FRACTION_BITS bits
+ * fractionnaires; les limites sont converties à la compilation avec toProfileAcceleration et
+ * toProfileJerk.
+ */
+class VelocityProfile
+{
+public:
+    /**
+     * @brief Constructeur de VelocityProfile.
+     * @param maxAcceleration Accélération maximale, par période de commande (virgule fixe).
+     * @param maxJerk Variation maximale de l'accélération par période (virgule fixe), 0 pour une
+     *        accélération appliquée immédiatement (profil trapézoïdal).
+     */
+    VelocityProfile(uint16_t maxAcceleration, uint16_t maxJerk);
+
+    /**
+     * @brief Destructeur par défaut de VelocityProfile.
+     */
+    ~VelocityProfile() = default;
+
+    /**
+     * @brief Change la consigne de vitesse, rejointe progressivement par update.
+     * @param velocity La vitesse visée.
+     */
+    void setTarget(int16_t velocity);
+
+    /**
+     * @brief Impose la vitesse et la consigne immédiatement, sans rampe (freinage).
+     * @param velocity La nouvelle vitesse.
+     */
+    void reset(int16_t velocity);
+
+    /**
+     * @brief Avance le profil d'une période de commande.
+     * @return int16_t La vitesse à appliquer pendant cette période.
+     */
+    int16_t update();
+
+    /**
+     * @brief Indique si le profil est au repos (vitesse, accélération et consigne nulles).
+     * @return true si la vitesse restera nulle aux prochaines périodes.
+     */
+    bool isAtRest() const;
+
+private:
+    uint16_t maxAcceleration_; // Accélération maximale par période.
+    uint16_t maxJerk_;         // Variation maximale de l'accélération par période.
+    int32_t target_;           // Consigne de vitesse.
+    int32_t velocity_;         // Vitesse courante.
+    int32_t acceleration_;     // Accélération courante.
+};
+
+#endif // VELOCITY_PROFILE_H
@@ -22,23 +22,23 @@ Wheel::Wheel(Timer<0> *timer, uint8_t directionPort, volatile uint8_t *ocrRegist
     ocrRegister_ = ocrRegister;
 };
 
-void Wheel::move(const double speed)
+void Wheel::move(const DutyCycle &speed)
 {
     timer_->setOCRnXRegister(speed, ocrRegister_);
 }
 
 void Wheel::stop()
 {
-    move(0.0);
+    move(DutyCycle{0});
 }
 
-void Wheel::turnWheelBackward(const double speed)
+void Wheel::turnWheelBackward(const DutyCycle &speed)
 {
     setRegisterBits(&PORTB, wheelDirectionPort_);
     move(speed);
 }
 
-void Wheel::turnWheelForward(const double speed)
+void Wheel::turnWheelForward(const DutyCycle &speed)
 {
     clearRegisterBits(&PORTB, wheelDirectionPort_);
     move(speed);
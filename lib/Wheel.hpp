@@ -58,21 +58,21 @@ public:
      *
      * @param speed Vitesse à laquelle la roue doit se déplacer.
      */
-    void move(const double speed);
+    void move(const DutyCycle &speed);
 
     /**
      * @brief Fait tourner la roue vers l'avant à une vitesse spécifiée.
      *
      * @param speed Vitesse à laquelle la roue doit se déplacer vers l'avant.
      */
-    void turnWheelForward(const double speed);
+    void turnWheelForward(const DutyCycle &speed);
 
     /**
      * @brief Fait tourner la roue vers l'arrière à une vitesse spécifiée.
      *
      * @param speed Vitesse à laquelle la roue doit se déplacer vers l'arrière.
      */
-    void turnWheelBackward(const double speed);
+    void turnWheelBackward(const DutyCycle &speed);
 
     /**
      * @brief Arrête la roue.
@@ -2,18 +2,18 @@
 #define CONSTS_LIB_H
 #include <stdint.h>
 #include <avr/io.h>
+#include "interfaces/struct/DutyCycle.hpp"
 //=========================================================== Navigation
 static const uint16_t DELAY_TURN_180_DEGRE = 1800;
 static const uint16_t DELAY_TURN_90_DEGRE = 900;
-static const uint16_t DELAY_STOP_AFTER_TURN = 500;
 // metttre deux vitesses differentes roue gauche superieure a droite
 // ajuster la roue de droite tourne moins vite que celle de gauche
-static const double PERCENT_TO_ADJUST = 0.056;
-static const double PERCENT_TO_ADJUST_TURN = 0.1;
-static const double SPEED_TO_TURN_FORWARD = 0.4;
-static const double SPEED_TO_TURN_BACKWARD = 0.4;
-static const double MAX_SPEED = 1;
-static const uint8_t DELAY_IMPULSION = 20;
+static constexpr DutyCycle PERCENT_TO_ADJUST = toDutyCycle(0.056);
+static constexpr DutyCycle PERCENT_TO_ADJUST_TURN = toDutyCycle(0.1);
+static constexpr DutyCycle SPEED_TO_TURN_FORWARD = toDutyCycle(0.4);
+static constexpr DutyCycle SPEED_TO_TURN_BACKWARD = toDutyCycle(0.4);
+static constexpr DutyCycle ARC_TURN_OUTER_SPEED = toDutyCycle(0.6); // Vitesse de la roue extérieure pendant un virage en arc.
+static constexpr DutyCycle ARC_TURN_INNER_SPEED = toDutyCycle(0.1); // Vitesse de la roue intérieure pendant un virage en arc.
 //=========================================================== Led
 static const uint8_t DELAY_GREEN_MS = 15;       // Durée d'allumage de la LED verte en millisecondes.
 static const uint8_t DELAY_RED_MS = 10;         // Durée d'allumage de la LED rouge en millisecondes.
@@ -26,6 +26,81 @@ static const uint8_t DIGITAL_OUTPUT_D2 = PA4;
 static const uint8_t DIGITAL_OUTPUT_D3 = PA5;
 static const uint8_t DIGITAL_OUTPUT_D4 = PA6;
 static const uint8_t DIGITAL_OUTPUT_D5 = PA7;
+static const uint8_t LINE_SENSOR_N_STATES = 32; // Nombre d'états possibles des cinq capteurs.
+// Poids des capteurs dans l'estimation de la position de la ligne (S1 à S5), de -LINE_POSITION_MAX à LINE_POSITION_MAX.
+static const int8_t LINE_POSITION_MAX = 100;
+static const int8_t LINE_SENSOR_WEIGHT_STEP = LINE_POSITION_MAX / 2;
+static const uint8_t LINE_EVENT_BUFFER_SIZE = 32; // Nombre de transitions des capteurs en attente (puissance de 2).
+//========================================================== LinePositionFilter
+static const uint8_t LINE_FILTER_MAX_WINDOW = 8;        // Taille maximale de la fenêtre de vote.
+static const uint8_t LINE_FILTER_WINDOW = 5;            // Échantillons de la fenêtre de vote (un par période de commande).
+static const uint8_t LINE_FILTER_VOTES = 3;             // Votes nécessaires dans la fenêtre pour qu'une position soit candidate.
+static const uint8_t LINE_FILTER_MIN_DWELL_PERIODS = 3; // Périodes de maintien avant de retenir une nouvelle position.
+static const uint8_t LINE_FILTER_MAX_REPLAY = 100;      // Périodes au plus rejouées après une attente de la boucle principale.
+//========================================================== PidController
+static const uint8_t PID_FRACTION_BITS = 8; // Nombre de bits fractionnaires des gains (format Q8.8).
+
+/**
+ * @brief Convertit un gain réel en gain PID au format Q8.8.
+ * @param gain Le gain réel.
+ * @return int16_t Le gain en virgule fixe.
+ */
+constexpr int16_t toPidGain(double gain)
+{
+    return static_cast<int16_t>(gain * (1 << PID_FRACTION_BITS) + (gain < 0 ? -0.5 : 0.5));
+}
+//========================================================== EventQueue
+static const uint8_t EVENT_QUEUE_SIZE = 16; // Nombre d'événements en attente (puissance de 2).
+static_assert((EVENT_QUEUE_SIZE & (EVENT_QUEUE_SIZE - 1)) == 0, "EVENT_QUEUE_SIZE doit etre une puissance de 2");
+//========================================================== ControlLoop
+static const uint16_t CONTROL_LOOP_FREQUENCY_HZ = 1000; // Fréquence visée de la boucle de commande (500 Hz à 2 kHz).
+//========================================================== ButtonDebouncer
+// Durées en périodes de commande (voir ControlLoop), converties depuis des millisecondes.
+static const uint8_t BUTTON_DEBOUNCER_MAX_BUTTONS = 4;                                      // Nombre maximal de boutons échantillonnés.
+static const uint8_t BUTTON_DEBOUNCE_PERIODS = 20UL * CONTROL_LOOP_FREQUENCY_HZ / 1000;     // Échantillons concordants pour changer d'état (20 ms).
+static const uint16_t BUTTON_LONG_PRESS_PERIODS = 600UL * CONTROL_LOOP_FREQUENCY_HZ / 1000; // Maintien avant l'appui long (600 ms).
+static const uint16_t BUTTON_REPEAT_PERIODS = 150UL * CONTROL_LOOP_FREQUENCY_HZ / 1000;     // Intervalle de répétition automatique (150 ms).
+static_assert(BUTTON_DEBOUNCE_PERIODS >= 1 && BUTTON_REPEAT_PERIODS <= BUTTON_LONG_PRESS_PERIODS, "Durees des boutons incoherentes");
+//========================================================== TimerWheel
+static const uint16_t TIMER_WHEEL_TICK_US = 1000;      // Période d'avance de la roue, en microsecondes de MonotonicClock.
+static const uint8_t TIMER_WHEEL_SLOTS = 16;           // Nombre de cases de la roue (puissance de 2).
+static const uint8_t TIMER_WHEEL_MAX_TIMERS = 8;       // Nombre maximal de minuteries.
+static const uint8_t TIMER_WHEEL_NO_TIMER = UINT8_MAX; // Identifiant invalide (fin de liste, création impossible).
+static const uint16_t TIMER_WHEEL_MAX_DELAY_MS = 30000; // Délai ou période maximale d'une minuterie.
+static_assert((TIMER_WHEEL_SLOTS & (TIMER_WHEEL_SLOTS - 1)) == 0, "TIMER_WHEEL_SLOTS doit etre une puissance de 2");
+static_assert(static_cast<uint32_t>(TIMER_WHEEL_MAX_DELAY_MS) * 1000 / TIMER_WHEEL_TICK_US < INT16_MAX, "TIMER_WHEEL_MAX_DELAY_MS depasse la moitie du cycle de la roue");
+//========================================================== Scheduler
+static const uint8_t SCHEDULER_MAX_TASKS = 4;        // Nombre maximal de tâches actives en même temps.
+static const uint16_t SCHEDULER_MAX_WAIT_MS = 15000; // Durée maximale d'une mise en veille ou d'une attente.
+//========================================================== VelocityProfile
+static const uint8_t PROFILE_FRACTION_BITS = 12; // Bits fractionnaires des vitesses et accélérations des profils.
+
+/**
+ * @brief Convertit une accélération en accélération de profil par période de commande.
+ * @param ratioPerSecond L'accélération, en rapport cyclique (0.0 à 1.0) par seconde.
+ * @return uint16_t L'accélération en virgule fixe par période.
+ */
+constexpr uint16_t toProfileAcceleration(double ratioPerSecond)
+{
+    return static_cast<uint16_t>(ratioPerSecond * DUTY_CYCLE_MAX * (1UL << PROFILE_FRACTION_BITS) / CONTROL_LOOP_FREQUENCY_HZ + 0.5);
+}
+
+/**
+ * @brief Convertit un jerk en variation d'accélération de profil par période de commande.
+ * @param ratioPerSecond2 Le jerk, en rapport cyclique (0.0 à 1.0) par seconde au carré.
+ * @return uint16_t Le jerk en virgule fixe par période.
+ */
+constexpr uint16_t toProfileJerk(double ratioPerSecond2)
+{
+    return static_cast<uint16_t>(ratioPerSecond2 * DUTY_CYCLE_MAX * (1UL << PROFILE_FRACTION_BITS) / CONTROL_LOOP_FREQUENCY_HZ / CONTROL_LOOP_FREQUENCY_HZ + 0.5);
+}
+
+// Avance/recul: pleine vitesse en 250 ms, accélération maximale atteinte en 100 ms.
+static constexpr uint16_t LINEAR_MAX_ACCELERATION = toProfileAcceleration(4.0);
+static constexpr uint16_t LINEAR_MAX_JERK = toProfileJerk(40.0);
+// Rotation (écart entre les roues): plus vive pour que les corrections du suivi de ligne restent rapides.
+static constexpr uint16_t ANGULAR_MAX_ACCELERATION = toProfileAcceleration(20.0);
+static constexpr uint16_t ANGULAR_MAX_JERK = 0;
 //========================================================== ObstacleDetector
 const uint8_t PRECISION_BIT_SHIFT = 2;
 const uint8_t DETECTOR_OUTPUT = PA0;
@@ -0,0 +1,22 @@
+/**
+ * @file ButtonEvent.h
+ * @brief Fichier d'en-tête définissant les événements émis par l'anti-rebond des boutons.
+ *
+ * Le code déposé dans la file d'événements est le premier code du bouton (voir
+ * ButtonDebouncer::addButton) plus la valeur de l'événement.
+ */
+
+#ifndef BUTTON_EVENT_H
+#define BUTTON_EVENT_H
+
+#include <stdint.h>
+
+// Énumération des événements d'un bouton, dans l'ordre des codes déposés dans la file.
+enum class ButtonEvent : uint8_t
+{
+    PRESSED,      // Appui stable (après anti-rebond).
+    LONG_PRESSED, // Bouton maintenu BUTTON_LONG_PRESS_PERIODS périodes.
+    REPEATED      // Répétition automatique, toutes les BUTTON_REPEAT_PERIODS périodes après l'appui long.
+};
+
+#endif
@@ -10,15 +10,18 @@
 #ifndef LINE_POSITION_H
 #define LINE_POSITION_H
 
+#include <stdint.h>
+
 /**
  * @enum LinePosition
  * @brief Énumération des différentes positions d'une ligne.
  *
  * LinePosition définit les différentes positions qu'une ligne peut occuper par rapport à un capteur ou
  * un robot. Elle inclut des positions telles que gauche, droite, centre, ainsi que des états spéciaux
- * comme perdu ou détecté à un croisement.
+ * comme perdu ou détecté à un croisement. Les positions sont stockées sur un octet dans la table
+ * des capteurs en mémoire flash (lue avec pgm_read_byte).
  */
-enum class LinePosition
+enum class LinePosition : uint8_t
 {
     MOST_LEFT,            // La ligne est la plus à gauche possible.
     LEFT,                 // La ligne est à gauche.
@@ -10,15 +10,18 @@
 #ifndef NOTE_FREQUENCY_H
 #define NOTE_FREQUENCY_H
 
+#include <stdint.h>
+
 /**
  * @enum Note
  * @brief Énumération des notes musicales avec leurs valeurs numériques correspondantes.
  *
  * Cette énumération associe des valeurs numériques à des notes musicales spécifiques, facilitant
  * leur utilisation dans des contextes nécessitant une représentation numérique des notes, comme
- * la synthèse sonore ou le traitement de signaux musicaux.
+ * la synthèse sonore ou le traitement de signaux musicaux. Les notes des mélodies sont stockées
+ * sur un octet en mémoire flash (lues avec pgm_read_byte).
  */
-enum class Note
+enum class Note : uint8_t
 {
     SILENCE = 0,
     A2 = 45,
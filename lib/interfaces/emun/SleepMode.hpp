@@ -0,0 +1,16 @@
+/**
+ * @file SleepMode.h
+ * @brief Fichier d'en-tête définissant les modes de veille utilisés par PowerManager.
+ */
+
+#ifndef SLEEP_MODE_H
+#define SLEEP_MODE_H
+
+// Énumération des modes de veille du microcontrôleur.
+enum class SleepMode
+{
+    IDLE,      // Processeur arrêté, timers et interruptions actifs: réveil au prochain débordement du timer 0.
+    POWER_DOWN // Horloges arrêtées: réveil seulement par une interruption asynchrone (changement de broche).
+};
+
+#endif
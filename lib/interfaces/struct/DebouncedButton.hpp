@@ -0,0 +1,22 @@
+#ifndef DEBOUNCED_BUTTON_H
+#define DEBOUNCED_BUTTON_H
+
+#include <stdint.h>
+
+class Button;
+
+/**
+ * @struct DebouncedButton
+ * @brief État de l'anti-rebond d'un bouton échantillonné par ButtonDebouncer.
+ */
+struct DebouncedButton
+{
+    const Button *button; // Bouton échantillonné.
+    uint8_t firstEvent;   // Code déposé pour ButtonEvent::PRESSED (les suivants pour les autres événements).
+    uint8_t integrator;   // Intégrateur d'anti-rebond, de 0 (relâché) à BUTTON_DEBOUNCE_PERIODS (appuyé).
+    bool isDown;          // État stable du bouton.
+    bool isLongPressed;   // L'appui long a déjà été signalé pour cet appui.
+    uint16_t heldPeriods; // Périodes écoulées depuis l'appui ou la dernière répétition.
+};
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef DURATION_H
+#define DURATION_H
+
+#include <stdint.h>
+#include "interfaces/utils.hpp"
+
+/**
+ * @class Milliseconds
+ * @brief Durée entière en millisecondes.
+ *
+ * Le constructeur est explicite: un nombre sans unité n'est jamais accepté là où une durée est
+ * attendue.
+ */
+class Milliseconds
+{
+public:
+    constexpr explicit Milliseconds(uint32_t count) : count_(count) {}
+
+    /**
+     * @brief Retourne la durée en millisecondes.
+     */
+    constexpr uint32_t count() const { return count_; }
+
+private:
+    uint32_t count_; // Nombre de millisecondes.
+};
+
+/**
+ * @class Seconds
+ * @brief Durée en secondes, éventuellement fractionnaire (1.25 s).
+ *
+ * La valeur est arrondie à la milliseconde à la compilation; une durée en secondes se convertit
+ * implicitement en Milliseconds, jamais l'inverse.
+ */
+class Seconds
+{
+public:
+    constexpr explicit Seconds(double value) : milliseconds_(static_cast<uint32_t>(value * 1000 + 0.5)) {}
+
+    constexpr operator Milliseconds() const { return Milliseconds(milliseconds_); }
+
+private:
+    uint32_t milliseconds_; // Durée convertie en millisecondes.
+};
+
+/**
+ * @class Ticks
+ * @brief Nombre de périodes d'un timer dont la période vaut TICK_US microsecondes.
+ *
+ * Deux timers de périodes différentes ont des types de ticks différents: leurs durées ne peuvent
+ * pas être mélangées. Une durée se convertit implicitement en ticks, arrondie au tick supérieur
+ * pour qu'un délai ne soit jamais raccourci, et bornée à UINT16_MAX ticks pour qu'une longue durée
+ * ne devienne jamais un délai court. La conversion a lieu chez l'appelant: elle est calculée à la
+ * compilation lorsque la durée est une constante.
+ *
+ * @tparam TICK_US Période du timer en microsecondes.
+ */
+template <uint32_t TICK_US>
+class Ticks
+{
+public:
+    static_assert(TICK_US > 0, "la periode du timer doit etre non nulle");
+
+    constexpr explicit Ticks(uint16_t count) : count_(count) {}
+
+    constexpr Ticks(const Milliseconds &duration) : count_(toCount(duration)) {}
+
+    constexpr Ticks(const Seconds &duration) : Ticks(static_cast<Milliseconds>(duration)) {}
+
+    /**
+     * @brief Retourne le nombre de périodes.
+     */
+    constexpr uint16_t count() const { return count_; }
+
+    /**
+     * @brief Retourne la durée correspondante, arrondie à la milliseconde inférieure.
+     */
+    constexpr Milliseconds toMilliseconds() const { return Milliseconds(static_cast<uint32_t>(count_) * TICK_US / 1000); }
+
+private:
+    // Durée à partir de laquelle le nombre de périodes dépasse UINT16_MAX.
+    static constexpr uint32_t MAX_DURATION_MS = static_cast<uint32_t>(UINT16_MAX) * TICK_US / 1000 + 1;
+
+    /**
+     * @brief Convertit une durée en périodes, arrondie à la période supérieure et bornée à UINT16_MAX.
+     */
+    static constexpr uint16_t toCount(const Milliseconds &duration)
+    {
+        // borne avant le calcul en microsecondes, qui pourrait déborder sur 32 bits
+        if (duration.count() >= MAX_DURATION_MS)
+            return UINT16_MAX;
+        uint32_t count = (duration.count() * 1000 + TICK_US - 1) / TICK_US;
+        return (count < UINT16_MAX) ? static_cast<uint16_t>(count) : UINT16_MAX;
+    }
+
+    uint16_t count_; // Nombre de périodes.
+};
+
+#endif // DURATION_H
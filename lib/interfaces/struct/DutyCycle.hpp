@@ -0,0 +1,49 @@
+#ifndef DUTY_CYCLE_H
+#define DUTY_CYCLE_H
+
+#include <stdint.h>
+
+constexpr uint8_t DUTY_CYCLE_MAX = 255; // Valeur d'un rapport cyclique de 100% (sommet du compteur PWM 8 bits).
+
+/**
+ * @struct DutyCycle
+ * @brief Rapport cyclique en virgule fixe, de 0 (0%) à DUTY_CYCLE_MAX (100%).
+ *
+ * La valeur est directement celle du registre OCR du PWM: appliquer un rapport cyclique ne demande
+ * aucun calcul en virgule flottante. Les constantes réelles sont converties à la compilation avec
+ * toDutyCycle.
+ */
+struct DutyCycle
+{
+    uint8_t value; // Valeur du rapport cyclique (comparaison du PWM).
+};
+
+/**
+ * @brief Convertit un rapport cyclique réel (0.0 à 1.0) en DutyCycle, arrondi et borné.
+ * @param ratio Le rapport cyclique réel.
+ * @return DutyCycle Le rapport cyclique en virgule fixe.
+ */
+constexpr DutyCycle toDutyCycle(double ratio)
+{
+    return DutyCycle{static_cast<uint8_t>(ratio <= 0.0 ? 0 : (ratio >= 1.0 ? DUTY_CYCLE_MAX : ratio * DUTY_CYCLE_MAX + 0.5))};
+}
+
+/**
+ * @brief Borne une valeur entière de rapport cyclique entre 0 et DUTY_CYCLE_MAX.
+ * @param value La valeur, éventuellement hors bornes.
+ * @return DutyCycle Le rapport cyclique borné.
+ */
+constexpr DutyCycle clampDutyCycle(int16_t value)
+{
+    return DutyCycle{static_cast<uint8_t>(value < 0 ? 0 : (value > DUTY_CYCLE_MAX ? DUTY_CYCLE_MAX : value))};
+}
+
+/**
+ * @brief Additionne deux rapports cycliques, avec saturation à 100%.
+ */
+constexpr DutyCycle operator+(const DutyCycle &left, const DutyCycle &right)
+{
+    return clampDutyCycle(static_cast<int16_t>(left.value) + right.value);
+}
+
+#endif // DUTY_CYCLE_H
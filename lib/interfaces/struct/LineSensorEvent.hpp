@@ -0,0 +1,16 @@
+#ifndef LINE_SENSOR_EVENT_H
+#define LINE_SENSOR_EVENT_H
+
+#include <stdint.h>
+
+/**
+ * @struct LineSensorEvent
+ * @brief Transition des capteurs de ligne capturée par l'interruption de changement de broche.
+ */
+struct LineSensorEvent
+{
+    uint8_t state;      // État des capteurs après la transition (bit 0 pour S1 jusqu'au bit 4 pour S5).
+    uint16_t timestamp; // Instant de la transition, en débordements du timer 0.
+};
+
+#endif
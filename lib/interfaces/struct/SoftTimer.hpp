@@ -0,0 +1,23 @@
+#ifndef SOFT_TIMER_H
+#define SOFT_TIMER_H
+
+#include <stdint.h>
+
+// Fonction appelée à l'échéance d'une minuterie, depuis l'interruption de la roue.
+using TimerCallback = void (*)(void *context);
+
+/**
+ * @struct SoftTimer
+ * @brief Minuterie logicielle de TimerWheel.
+ */
+struct SoftTimer
+{
+    TimerCallback callback; // Fonction appelée à l'échéance (nullptr: minuterie libre).
+    void *context;          // Paramètre passé à la fonction.
+    uint16_t expiry;        // Tick de la roue de la prochaine échéance.
+    uint16_t period;        // Période en ticks (0: minuterie à une seule échéance).
+    uint8_t next;           // Minuterie suivante de la même case de la roue.
+    bool isActive;          // La minuterie est armée.
+};
+
+#endif
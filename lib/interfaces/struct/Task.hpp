@@ -0,0 +1,30 @@
+#ifndef TASK_H
+#define TASK_H
+
+#include <stdint.h>
+
+struct Task;
+
+/**
+ * @brief Corps d'une tâche coopérative.
+ *
+ * La fonction reprend là où elle s'était arrêtée (voir TASK_BEGIN dans Scheduler.hpp) et retourne
+ * vrai tant que la tâche n'est pas terminée.
+ */
+using TaskFunction = bool (*)(Task &task);
+
+/**
+ * @struct Task
+ * @brief État d'une tâche coopérative conservé entre deux reprises.
+ */
+struct Task
+{
+    TaskFunction function; // Corps de la tâche.
+    void *context;         // Objet sur lequel la tâche agit.
+    uint16_t resumePoint;  // Point de reprise dans le corps de la tâche (0 au démarrage).
+    uint16_t sleepTicks;   // Durée de la mise en veille demandée, en ticks de l'ordonnanceur.
+    uint16_t wakeTick;     // Tick de l'ordonnanceur auquel la tâche reprend.
+    uint8_t counter;       // Compteur de boucle conservé entre deux reprises.
+};
+
+#endif